@@ -0,0 +1,40 @@
+#include "lib/pi.hpp"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+
+// Writes the definitions of the tables declared in lib/pi.hpp, so that the binary carries pi in
+// the form ball arithmetic uses and never has to parse it at runtime.
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: pi-table <output.cpp>\n";
+        return 1;
+    }
+    auto out = std::ofstream(argv[1]);
+
+    auto write = [&](const std::vector<std::uint64_t>& limbs) {
+        for (auto i = 0; i < limbs.size(); i++) {
+            out << (i % 4 == 0 ? "    " : " ") << std::format("0x{:016x},", limbs[i])
+                << (i % 4 == 3 || i + 1 == limbs.size() ? "\n" : "");
+        }
+    };
+
+    out << "// Generated by gen/pi_table.cpp, do not edit.\n";
+    out << "#include \"lib/pi.hpp\"\n\n";
+    out << "const std::uint64_t pi::LIMBS[pi::LIMB_COUNT] = {\n";
+    write(pi::chudnovsky(pi::TABLE_BITS));
+    out << "};\n\n";
+    out << "const std::uint64_t pi::POWERS[pi::POWER_COUNT][pi::POWER_LIMBS] = {\n";
+    for (auto k = 0U; k < pi::POWER_COUNT; k++) {
+        out << "{\n";
+        write(pi::chudnovsky(pi::POWER_BITS, k));
+        out << "},\n";
+    }
+    out << "};\n";
+
+    if (!out) {
+        std::cerr << "failed to write " << argv[1] << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,113 @@
+#include "ball.hpp"
+
+#include "pi.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace ball {
+    Int shift_right_ceil(const Int& x, int bits) {
+        assert(x >= 0);
+        return (x + (Int(1) << bits) - 1) >> bits;
+    }
+
+    Ball multiply(const Ball& lhs, const Ball& rhs, int bits) {
+        auto exact = lhs * rhs;
+        // Shifting the midpoint may round it either way, one more ulp of radius covers that.
+        return {.mid{exact.mid >> bits}, .rad{shift_right_ceil(exact.rad, bits) + 1}};
+    }
+
+    Ball operator*(const Ball& lhs, const Ball& rhs) {
+        return {.mid{lhs.mid * rhs.mid},
+                .rad{abs(lhs.mid) * rhs.rad + abs(rhs.mid) * lhs.rad + lhs.rad * rhs.rad}};
+    }
+
+    Ball operator-(const Ball& lhs, const Ball& rhs) {
+        return {.mid{lhs.mid - rhs.mid}, .rad{lhs.rad + rhs.rad}};
+    }
+
+    std::optional<int> sign(const Ball& b) {
+        if (b.mid > b.rad) {
+            return 1;
+        }
+        if (-b.mid > b.rad) {
+            return -1;
+        }
+        return std::nullopt;
+    }
+
+    Int from_decimal(std::string_view magnitude, bool negative) {
+        if (magnitude.empty()) {
+            return 0;
+        }
+        auto i = Int(std::string(magnitude));
+        return negative ? Int(-i) : i;
+    }
+
+    int max_bits() { return static_cast<int>(pi::MAX_BITS); }
+
+    // A ball with `bits` fractional bits around a number given as limbs with `fraction_bits`
+    // fractional bits, which may be off by one.
+    Ball from_limbs(std::span<const std::uint64_t> limbs, std::size_t fraction_bits, int bits) {
+        assert(bits <= fraction_bits);
+        auto x = Int();
+        import_bits(x, limbs.begin(), limbs.end(), 64);
+        // Off by one before the shift, and by less than one more after it.
+        return {.mid{x >> (fraction_bits - bits)}, .rad{2}};
+    }
+
+    Ball pi(int bits) {
+        assert(bits <= max_bits());
+        auto limbs = pi::limbs(bits);
+        // Only the limbs holding the first `bits` fractional bits.
+        auto count = (static_cast<std::size_t>(bits) + 63) / 64 + 1;
+        return from_limbs(limbs.first(count), (count - 1) * 64, bits);
+    }
+
+    std::shared_ptr<const std::vector<Ball>> pi_powers(int bits, std::size_t count) {
+        static auto mutex = std::mutex();
+        static auto tables = std::map<int, std::shared_ptr<const std::vector<Ball>>>();
+        auto lock = std::scoped_lock(mutex);
+        auto& table = tables[bits];
+        if (table != nullptr && table->size() >= count) {
+            return table;
+        }
+
+        // Grown geometrically, so that asking for one more power at a time copies little.
+        auto grown = table == nullptr ? std::vector<Ball>() : *table;
+        auto target = std::max(count, 2 * grown.size());
+        grown.reserve(target);
+        if (grown.empty()) {
+            grown.push_back({.mid{Int(1) << bits}, .rad{0}});
+        }
+        while (grown.size() < std::min(target, pi::POWER_COUNT) && bits <= pi::POWER_BITS) {
+            grown.push_back(from_limbs(pi::POWERS[grown.size()], pi::POWER_BITS, bits));
+        }
+        if (grown.size() < target && grown.size() == 1) {
+            grown.push_back(pi(bits));
+        }
+        while (grown.size() < target) {
+            grown.push_back(multiply(grown.back(), grown[1], bits));
+        }
+        table = std::make_shared<const std::vector<Ball>>(std::move(grown));
+        return table;
+    }
+
+    Ball evaluate(std::span<const Int> coefficients, int bits) {
+        auto table = pi_powers(bits, coefficients.size());
+        const auto& powers = *table;
+        auto result = Ball{.mid{0}, .rad{0}};
+        for (auto i = 0; i < coefficients.size(); i++) {
+            const auto& c = coefficients[i];
+            if (c.is_zero()) {
+                continue;
+            }
+            result.mid += c * powers[i].mid;
+            result.rad += abs(c) * powers[i].rad;
+        }
+        return result;
+    }
+} // namespace ball
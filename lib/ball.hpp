@@ -0,0 +1,43 @@
+#pragma once
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ball {
+    // Without expression templates, so that `auto` always holds a value.
+    using Int = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<>,
+                                              boost::multiprecision::et_off>;
+
+    // A real number known to lie within [mid - rad, mid + rad] * 2^-bits, where the number of
+    // fractional bits is fixed by whoever made the ball.
+    struct Ball {
+        Int mid;
+        Int rad;
+    };
+
+    // The product of two balls with `bits` fractional bits, rounded back to `bits`.
+    [[nodiscard]] Ball multiply(const Ball& lhs, const Ball& rhs, int bits);
+    // The exact product, whose fractional bits are the sum of both operands'.
+    [[nodiscard]] Ball operator*(const Ball& lhs, const Ball& rhs);
+    [[nodiscard]] Ball operator-(const Ball& lhs, const Ball& rhs);
+    // The sign of every number in the ball, or nullopt if it contains zero.
+    [[nodiscard]] std::optional<int> sign(const Ball& b);
+
+    [[nodiscard]] Int from_decimal(std::string_view magnitude, bool negative);
+
+    // The highest precision that the bits of pi from pi.hpp can back.
+    [[nodiscard]] int max_bits();
+    // An enclosure of pi with `bits` fractional bits.
+    [[nodiscard]] Ball pi(int bits);
+    // Enclosures of pi^0 ... pi^(count - 1) at least, with `bits` fractional bits. The tables are
+    // built once per precision, starting from the compiled powers when they're precise enough,
+    // and shared by the whole process. A table is never changed once returned, a call needing
+    // more powers makes a bigger one, so holding one is safe on any thread.
+    [[nodiscard]] std::shared_ptr<const std::vector<Ball>> pi_powers(int bits, std::size_t count);
+    // sum(coefficients[i] * pi^i) with `bits` fractional bits.
+    [[nodiscard]] Ball evaluate(std::span<const Int> coefficients, int bits);
+} // namespace ball
@@ -0,0 +1,120 @@
+#include "pi.hpp"
+
+#include <algorithm>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cassert>
+#include <cmath>
+#include <future>
+#include <iterator>
+#include <thread>
+
+namespace pi {
+    using Int = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<>,
+                                              boost::multiprecision::et_off>;
+
+    // The Chudnovsky series sum((-1)^k (6k)! (13591409 + 545140134k) / ((3k)! (k!)^3 640320^3k))
+    // over [a, b) is T / Q, with P carrying the running ratio between consecutive terms.
+    struct Split {
+        Int p;
+        Int q;
+        Int t;
+    };
+
+    Split combine(const Split& lhs, const Split& rhs) {
+        return {.p{lhs.p * rhs.p}, .q{lhs.q * rhs.q}, .t{lhs.t * rhs.q + lhs.p * rhs.t}};
+    }
+
+    Split binary_split(long a, long b) {
+        if (b - a == 1) {
+            if (a == 0) {
+                return {.p{1}, .q{1}, .t{13591409}};
+            }
+            // 640320^3 / 24
+            const auto c3_24 = Int(10939058860032000);
+            auto p = Int(6 * a - 5) * (2 * a - 1) * (6 * a - 1);
+            auto q = Int(a) * a * a * c3_24;
+            auto t = p * (Int(545140134) * a + 13591409);
+            return {.p{std::move(p)}, .q{std::move(q)}, .t{a % 2 == 0 ? t : Int(-t)}};
+        }
+        auto m = (a + b) / 2;
+        return combine(binary_split(a, m), binary_split(m, b));
+    }
+
+    // Splits the range across 2^depth threads.
+    Split parallel_split(long a, long b, int depth) {
+        if (depth == 0 || b - a < 64) {
+            return binary_split(a, b);
+        }
+        auto m = (a + b) / 2;
+        auto lhs = std::async(std::launch::async, parallel_split, a, m, depth - 1);
+        auto rhs = parallel_split(m, b, depth - 1);
+        return combine(lhs.get(), rhs);
+    }
+
+    Int isqrt(const Int& n) {
+        if (n < 2) {
+            return n;
+        }
+        auto bits = msb(n);
+        auto x = Int();
+        if (bits < 52) {
+            x = Int(static_cast<unsigned long long>(std::sqrt(n.convert_to<double>()))) + 2;
+        } else {
+            // Starting from the root of the top half of the bits takes only a couple of Newton
+            // steps at full precision.
+            auto shift = bits / 4;
+            x = (isqrt(n >> (2 * shift)) + 1) << shift;
+        }
+        // Newton's method decreases monotonically from above to the floor of the root.
+        while (true) {
+            Int y = (x + n / x) >> 1;
+            if (y >= x) {
+                return x;
+            }
+            x = std::move(y);
+        }
+    }
+
+    // pi * scale, off by a few units at most.
+    Int scaled(const Int& scale) {
+        // Each term adds a bit over 47 bits.
+        auto terms = static_cast<long>(msb(scale) / 47) + 2;
+
+        auto threads = std::max(1U, std::thread::hardware_concurrency());
+        auto depth = static_cast<int>(std::log2(threads));
+        auto root = std::async(std::launch::async, [&] { return isqrt(scale * scale * 10005); });
+        auto split = parallel_split(0, terms, depth);
+
+        // pi = 426880 sqrt(10005) Q / T
+        return Int(426880) * root.get() * split.q / split.t;
+    }
+
+    std::vector<std::uint64_t> chudnovsky(std::size_t bits, unsigned power) {
+        assert(bits % 64 == 0);
+        // Guard bits absorb the truncation of the divisions, and the error growing with each
+        // power.
+        const auto guard = 64;
+        auto precision = bits + guard;
+        auto x = scaled(Int(1) << precision);
+        auto result = Int(1) << precision;
+        for (auto i = 0U; i < power; i++) {
+            result = (result * x) >> precision;
+        }
+        result >>= guard;
+
+        auto limbs = std::vector<std::uint64_t>();
+        export_bits(result, std::back_inserter(limbs), 64);
+        // Pad the integer part out to a whole limb.
+        auto count = bits / 64 + 1;
+        assert(limbs.size() <= count);
+        limbs.insert(limbs.begin(), count - limbs.size(), 0);
+        return limbs;
+    }
+
+    std::string decimal_digits(std::size_t count) {
+        const auto guard = 16;
+        auto digits = scaled(pow(Int(10), static_cast<unsigned>(count - 1 + guard))).str();
+        digits.resize(count);
+        return digits;
+    }
+} // namespace pi
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <bit>
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace hamt {
+    // A persistent hash array mapped trie. Copies share every node and setting an entry copies
+    // only the shared nodes on its path, changing the rest in place, so both take O(log n) at
+    // most, and copies never see each other's changes. Each Entry carries its own 64-bit `hash`,
+    // and every lookup passes a predicate telling whether an entry with that hash is the one it
+    // wants.
+    //
+    // The leaves are flat tables laid out like a Swiss table: a control byte per slot holds 7 bits
+    // of the hash so that probing checks 8 slots at once, and each slot holds its entry, hash
+    // included, in place. Up to GROUP entries are kept packed instead, with no control bytes, and
+    // found by comparing their hashes in turn. A leaf that fills up is split by the next bits of
+    // the hashes.
+    template <typename Entry> class Map {
+      private:
+        static constexpr int BITS = 5;
+        static constexpr std::uint64_t MASK = (1 << BITS) - 1;
+        // Below this every hash bit has been used, so a leaf only grows.
+        static constexpr int MAX_SHIFT = 64;
+        static constexpr std::size_t GROUP = 8;
+        // Past this many slots a leaf is split rather than grown.
+        static constexpr std::size_t LEAF_SLOTS = 32;
+        static constexpr std::uint8_t EMPTY = 0x80;
+        static constexpr std::uint64_t LOW_BITS = 0x0101010101010101;
+        static constexpr std::uint64_t HIGH_BITS = 0x8080808080808080;
+
+        struct Leaf {
+            // A control byte and a slot for each of a power of two, more than GROUP, positions.
+            // Empty while the entries are packed, when there is a slot per entry.
+            std::vector<std::uint8_t> control;
+            std::vector<std::optional<Entry>> slots;
+            std::size_t size{0};
+        };
+        struct Node;
+        // Null for an empty leaf.
+        using Child = std::variant<std::shared_ptr<Leaf>, std::shared_ptr<Node>>;
+        struct Node {
+            // Which of the 32 positions are taken.
+            std::uint32_t bitmap{0};
+            // By position.
+            boost::container::small_vector<Child, 4> children;
+        };
+
+        // For entries known to be different.
+        struct Never {
+            bool operator()(const Entry& /*e*/) const { return false; }
+        };
+
+        Child m_root;
+        std::size_t m_size{0};
+
+        static std::uint32_t bit(std::uint64_t hash, int shift) {
+            return std::uint32_t{1} << ((hash >> shift) & MASK);
+        }
+        static std::size_t position(const Node& node, std::uint32_t bit) {
+            return std::popcount(node.bitmap & (bit - 1));
+        }
+
+        // The top 7 bits of the hash, while the low ones pick where probing starts.
+        static std::uint8_t tag(std::uint64_t hash) {
+            return static_cast<std::uint8_t>(hash >> 57);
+        }
+
+        static std::uint64_t load(const Leaf& leaf, std::size_t pos) {
+            auto group = std::uint64_t{0};
+            for (auto i = 0; i < GROUP; i++) {
+                group |= std::uint64_t{leaf.control[pos + i]} << (8 * i);
+            }
+            return group;
+        }
+
+        // The high bit of every byte of the group equal to `byte`, give or take a false positive
+        // next to a true one.
+        static std::uint64_t match(std::uint64_t group, std::uint8_t byte) {
+            auto x = group ^ (LOW_BITS * byte);
+            return (x - LOW_BITS) & ~x & HIGH_BITS;
+        }
+
+        // Groups are visited in triangular steps, which reaches all of them since their count is
+        // a power of two. The bits the trie already used to get here say nothing within the leaf.
+        template <typename F>
+        static void probe(const Leaf& leaf, std::uint64_t hash, int shift, F f) {
+            auto mask = leaf.slots.size() - 1;
+            auto pos = std::rotr(hash, shift) & mask & ~(GROUP - 1);
+            for (auto step = GROUP;; pos = (pos + step) & mask, step += GROUP) {
+                if (f(pos, load(leaf, pos))) {
+                    return;
+                }
+            }
+        }
+
+        template <typename F>
+        static std::optional<std::size_t> find_slot(const Leaf& leaf, std::uint64_t hash,
+                                                    int shift, F& same) {
+            auto found = std::optional<std::size_t>();
+            if (leaf.control.empty()) {
+                for (auto i = std::size_t{0}; i < leaf.slots.size(); i++) {
+                    const auto& e = *leaf.slots[i];
+                    if (e.hash == hash && same(e)) {
+                        return i;
+                    }
+                }
+                return found;
+            }
+            probe(leaf, hash, shift, [&](std::size_t pos, std::uint64_t group) {
+                for (auto bits = match(group, tag(hash)); bits != 0; bits &= bits - 1) {
+                    auto i = pos + std::countr_zero(bits) / 8;
+                    const auto& e = leaf.slots[i];
+                    if (e && e->hash == hash && same(*e)) {
+                        found = i;
+                        return true;
+                    }
+                }
+                return (group & HIGH_BITS) != 0;
+            });
+            return found;
+        }
+
+        static void place(Leaf& leaf, int shift, Entry&& entry) {
+            probe(leaf, entry.hash, shift, [&](std::size_t pos, std::uint64_t group) {
+                auto empty = group & HIGH_BITS;
+                if (empty == 0) {
+                    return false;
+                }
+                auto i = pos + std::countr_zero(empty) / 8;
+                leaf.control[i] = tag(entry.hash);
+                leaf.slots[i].emplace(std::move(entry));
+                return true;
+            });
+            leaf.size++;
+        }
+
+        static void grow(Leaf& leaf, int shift) {
+            auto slots = std::move(leaf.slots);
+            auto capacity = leaf.control.empty() ? GROUP * 2 : slots.size() * 2;
+            leaf.control.assign(capacity, EMPTY);
+            leaf.slots = std::vector<std::optional<Entry>>(capacity);
+            leaf.size = 0;
+            // The hashes are kept, so nothing is hashed again.
+            for (auto& e : slots) {
+                if (e) {
+                    place(leaf, shift, std::move(*e));
+                }
+            }
+        }
+
+        // `ptr`, made if it's null, and copied first if anything else shares it. Either sets
+        // `moved`.
+        template <typename T> static T& own(std::shared_ptr<T>& ptr, bool& moved) {
+            if (ptr == nullptr) {
+                ptr = std::make_shared<T>();
+                moved = true;
+            } else if (ptr.use_count() > 1) {
+                ptr = std::make_shared<T>(std::as_const(*ptr));
+                moved = true;
+            }
+            return *ptr;
+        }
+
+        // Sets `entry` under `child`, whose entries have hashes alike below `shift`. `same` tells
+        // whether an entry is to be replaced. Sets `added` if none is, and `moved` if any entry
+        // may be somewhere else now, which adding one always can.
+        template <typename F>
+        static void set(Child& child, int shift, Entry&& entry, F& same, bool& added,
+                        bool& moved) {
+            if (auto* ptr = std::get_if<std::shared_ptr<Leaf>>(&child)) {
+                auto& leaf = own(*ptr, moved);
+                if (auto i = find_slot(leaf, entry.hash, shift, same)) {
+                    *leaf.slots[*i] = std::move(entry);
+                    return;
+                }
+                added = true;
+                moved = true;
+                if (leaf.control.empty() && leaf.size < GROUP) {
+                    leaf.slots.emplace_back(std::move(entry));
+                    leaf.size++;
+                    return;
+                }
+                // At most 7 / 8 full, so that probing always meets an empty slot.
+                if (leaf.control.empty() || (leaf.size + 1) * 8 > leaf.slots.size() * 7) {
+                    if (leaf.slots.size() >= LEAF_SLOTS && shift < MAX_SHIFT) {
+                        child = split(leaf, shift);
+                        auto never = Never();
+                        auto ignored = false;
+                        set(child, shift, std::move(entry), never, ignored, ignored);
+                        return;
+                    }
+                    grow(leaf, shift);
+                }
+                place(leaf, shift, std::move(entry));
+                return;
+            }
+
+            auto& node = own(std::get<std::shared_ptr<Node>>(child), moved);
+            auto b = bit(entry.hash, shift);
+            auto i = position(node, b);
+            if ((node.bitmap & b) == 0) {
+                node.bitmap |= b;
+                node.children.emplace(node.children.begin() + i, std::shared_ptr<Leaf>());
+            }
+            set(node.children[i], shift + BITS, std::move(entry), same, added, moved);
+        }
+
+        // A node holding the entries of `leaf`, which is this map's own, parted by the bits of
+        // their hashes at `shift`.
+        static Child split(Leaf& leaf, int shift) {
+            auto node = Child(std::make_shared<Node>());
+            auto never = Never();
+            auto ignored = false;
+            for (auto& e : leaf.slots) {
+                if (e) {
+                    set(node, shift, std::move(*e), never, ignored, ignored);
+                }
+            }
+            return node;
+        }
+
+        template <typename F> static void for_each(const Child& child, F& f) {
+            if (const auto* leaf = std::get_if<std::shared_ptr<Leaf>>(&child)) {
+                if (*leaf != nullptr) {
+                    for (const auto& e : (*leaf)->slots) {
+                        if (e) {
+                            f(*e);
+                        }
+                    }
+                }
+                return;
+            }
+            for (const auto& c : std::get<std::shared_ptr<Node>>(child)->children) {
+                for_each(c, f);
+            }
+        }
+
+      public:
+        [[nodiscard]] std::size_t size() const { return m_size; }
+
+        template <typename F> [[nodiscard]] const Entry* find(std::uint64_t hash, F same) const {
+            const auto* child = &m_root;
+            for (auto shift = 0;; shift += BITS) {
+                if (const auto* leaf = std::get_if<std::shared_ptr<Leaf>>(child)) {
+                    if (*leaf == nullptr) {
+                        return nullptr;
+                    }
+                    auto i = find_slot(**leaf, hash, shift, same);
+                    return i ? &*(*leaf)->slots[*i] : nullptr;
+                }
+                const auto& node = *std::get<std::shared_ptr<Node>>(*child);
+                auto b = bit(hash, shift);
+                if ((node.bitmap & b) == 0) {
+                    return nullptr;
+                }
+                child = &node.children[position(node, b)];
+            }
+        }
+
+        // Adds `entry`, or replaces the entry that `same` picks out among those with its hash,
+        // in place. Returns whether entries found before may be somewhere else now, which is
+        // only when one was added or nodes on the path were copied.
+        template <typename F> bool set(Entry entry, F same) {
+            auto added = false;
+            auto moved = false;
+            set(m_root, 0, std::move(entry), same, added, moved);
+            if (added) {
+                m_size++;
+            }
+            return moved;
+        }
+
+        // The entry that `same` picks out among those with `hash`, which has to be there, made
+        // this map's own to change. Its hash, and whatever `same` looks at, must stay the same.
+        // Sets `moved` if it's somewhere else now.
+        template <typename F>
+        [[nodiscard]] Entry& edit(std::uint64_t hash, F same, bool& moved) {
+            auto* child = &m_root;
+            for (auto shift = 0;; shift += BITS) {
+                if (auto* ptr = std::get_if<std::shared_ptr<Leaf>>(child)) {
+                    auto& leaf = own(*ptr, moved);
+                    return *leaf.slots[*find_slot(leaf, hash, shift, same)];
+                }
+                auto& node = own(std::get<std::shared_ptr<Node>>(*child), moved);
+                child = &node.children[position(node, bit(hash, shift))];
+            }
+        }
+
+        template <typename F> void for_each(F f) const { for_each(m_root, f); }
+    };
+} // namespace hamt
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace mpmc {
+    // A bounded queue that any number of threads push to and pop from without locking. Every slot
+    // has a sequence number telling which lap around the queue it's ready to be written or read
+    // in, so claiming a position only takes a compare and swap on the tail or head.
+    template <typename T> class Queue {
+      private:
+        // Kept apart, so that pushing and popping threads don't fight over a cache line.
+        static constexpr std::size_t CACHE_LINE = 64;
+
+        struct Slot {
+            std::atomic<std::size_t> sequence;
+            std::optional<T> value;
+        };
+
+        std::size_t m_mask;
+        std::unique_ptr<Slot[]> m_slots;
+        alignas(CACHE_LINE) std::atomic<std::size_t> m_tail{0};
+        alignas(CACHE_LINE) std::atomic<std::size_t> m_head{0};
+
+        [[nodiscard]] static std::intptr_t lap(std::size_t sequence, std::size_t pos) {
+            return static_cast<std::intptr_t>(sequence - pos);
+        }
+
+      public:
+        // Room for `capacity` rounded up to a power of 2, and at least 2, as with one slot a write
+        // would leave it looking ready for the next.
+        explicit Queue(std::size_t capacity)
+            : m_mask{std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1},
+              m_slots{std::make_unique<Slot[]>(m_mask + 1)} {
+            for (auto i = std::size_t{0}; i <= m_mask; i++) {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // Leaves `value` as it was if the queue is full.
+        [[nodiscard]] bool try_push(T&& value) {
+            auto pos = m_tail.load(std::memory_order_relaxed);
+            while (true) {
+                auto& slot = m_slots[pos & m_mask];
+                auto diff = lap(slot.sequence.load(std::memory_order_acquire), pos);
+                if (diff == 0) {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        slot.value.emplace(std::move(value));
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    // Not yet read since the last lap.
+                    return false;
+                } else {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        [[nodiscard]] std::optional<T> try_pop() {
+            auto pos = m_head.load(std::memory_order_relaxed);
+            while (true) {
+                auto& slot = m_slots[pos & m_mask];
+                auto diff = lap(slot.sequence.load(std::memory_order_acquire), pos + 1);
+                if (diff == 0) {
+                    if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        auto value = std::exchange(slot.value, std::nullopt);
+                        slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                        return value;
+                    }
+                } else if (diff < 0) {
+                    // Not yet written in this lap.
+                    return std::nullopt;
+                } else {
+                    pos = m_head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+} // namespace mpmc
@@ -1,16 +1,24 @@
 #include "number.hpp"
 
+#include "ball.hpp"
+#include "roots.hpp"
 #include "macros.hpp"
-#include "pi.hpp"
 
 #include "vendor/BigInt.hpp"
+#include <array>
 #include <cassert>
+#include <charconv>
 #include <climits>
 #include <cmath>
 #include <iterator>
+#include <limits>
+#include <map>
+#include <numbers>
+#include <numeric>
 #include <sstream>
 #include <string_view>
 #include <tl/expected.hpp>
+#include <utility>
 #include <vector>
 
 namespace number {
@@ -19,6 +27,13 @@ namespace number {
                c == '_';
     }
 
+    // Coefficients of up to SMALL_DIGITS digits, in polynomials of up to SMALL_TERMS terms, are
+    // added and multiplied as machine integers rather than as decimal strings. A product of two is
+    // below 10^18, so a sum of two sums of SMALL_TERMS products still fits an int64.
+    constexpr std::size_t SMALL_DIGITS = 9;
+    constexpr std::size_t SMALL_TERMS = 4;
+    using Small = boost::container::small_vector<std::int64_t, 2 * SMALL_TERMS>;
+
     template <typename T, typename I> class RotateableIndex {
       private:
         const T m_t;
@@ -106,26 +121,119 @@ namespace number {
         return strr;
     }
 
-    Value::Value(std::string_view letters) : m_denominator{1} {
+    Coefficients::Coefficients(std::string_view digits, std::span<const Term> terms)
+        : m_digits{digits}, m_terms{terms} {}
+
+    std::size_t Coefficients::size() const { return m_terms.size(); }
+
+    bool Coefficients::empty() const { return m_terms.empty(); }
+
+    std::string_view Coefficients::magnitude(std::size_t i) const {
+        return m_digits.substr(m_terms[i].offset, m_terms[i].length);
+    }
+
+    bool Coefficients::is_zero(std::size_t i) const { return m_terms[i].length == 0; }
+
+    bool Coefficients::is_negative(std::size_t i) const { return m_terms[i].negative; }
+
+    BigInt Coefficients::operator[](std::size_t i) const {
+        if (is_zero(i)) {
+            return 0;
+        }
+        auto s = std::string();
+        s.reserve(m_terms[i].length + 1);
+        if (is_negative(i)) {
+            s.push_back('-');
+        }
+        s.append(magnitude(i));
+        return BigInt(s);
+    }
+
+    BigInt Coefficients::back() const { return (*this)[size() - 1]; }
+
+    bool Coefficients::term_equal(std::size_t i, const Coefficients& rhs, std::size_t j) const {
+        return is_negative(i) == rhs.is_negative(j) && magnitude(i) == rhs.magnitude(j);
+    }
+
+    std::vector<BigInt> Coefficients::to_vector() const {
+        auto v = std::vector<BigInt>();
+        v.reserve(size());
+        for (auto i = 0; i < size(); i++) {
+            v.push_back((*this)[i]);
+        }
+        return v;
+    }
+
+    bool operator==(const Coefficients& lhs, const std::vector<BigInt>& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (auto i = 0; i < lhs.size(); i++) {
+            if (lhs[i] != rhs[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename V> void Value::assign(const V& num, const V& den) {
+        m_digits.clear();
+        m_terms.clear();
+        m_terms.reserve(num.size() + den.size());
+        auto push = [&](const auto& n) {
+            auto offset = static_cast<std::uint32_t>(m_digits.size());
+            auto negative = false;
+            if constexpr (std::is_same_v<std::decay_t<decltype(n)>, BigInt>) {
+                if (n != 0) {
+                    auto s = n.to_string();
+                    negative = s[0] == '-';
+                    m_digits.append(std::string_view(s).substr(negative ? 1 : 0));
+                }
+            } else if (n != 0) {
+                auto buffer = std::array<char, 20>();
+                negative = n < 0;
+                auto end = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                                         negative ? -n : n)
+                               .ptr;
+                m_digits.append(buffer.data(), end);
+            }
+            m_terms.push_back({.offset{offset},
+                               .length{static_cast<std::uint32_t>(m_digits.size() - offset)},
+                               .negative{negative}});
+        };
+        for (const auto& n : num) {
+            push(n);
+        }
+        for (const auto& n : den) {
+            push(n);
+        }
+        m_numerator_size = num.size();
+    }
+
+    Value::Value(std::string_view letters) {
         auto min_letters{lexicographically_minimal_rotation(letters)};
 
+        auto num = std::vector<BigInt>();
+        num.reserve(letters.size());
         BigInt base{1};
         for (auto l : min_letters) {
-            m_numerator.push_back(base * l);
+            num.push_back(base * l);
             base *= LETTER_BASE;
         }
+        assign(num, std::vector<BigInt>{1});
     }
 
-    Value::Value(const BigInt& number) : m_numerator{0, number}, m_denominator{1} {
+    Value::Value(const BigInt& number) {
         if (number == 0) {
-            m_numerator.clear();
+            assign(std::vector<BigInt>{}, std::vector<BigInt>{1});
+        } else {
+            assign(std::vector<BigInt>{0, number}, std::vector<BigInt>{1});
         }
     }
 
     // There is no analytical algorithm to find factorize arbitrary degree polynomial, so this is
     // best effort
-    std::pair<std::vector<BigInt>, std::vector<BigInt>> simplify(const std::vector<BigInt>& num,
-                                                                 const std::vector<BigInt>& den) {
+    template <typename V> std::pair<V, V> simplify(const V& num, const V& den) {
         // remove trailing zero
         auto num_size = num.size();
         while (num_size > 0 && num[num_size - 1] == 0) {
@@ -148,23 +256,30 @@ namespace number {
         auto leading_zero = std::min(leading_zero_num, leading_zero_dem);
 
         // factor out gcd
-        auto g = BigInt(1);
+        auto g = typename V::value_type(1);
+        auto add_factor = [&](const auto& n) {
+            if constexpr (std::is_same_v<typename V::value_type, BigInt>) {
+                g = gcd(g, n);
+            } else {
+                g = std::gcd(g, n);
+            }
+        };
         if (num_size > leading_zero && dem_size > leading_zero) {
             g = 0;
             for (auto i = leading_zero; i < num_size; i++) {
-                g = gcd(g, num[i]);
+                add_factor(num[i]);
             }
             for (auto i = leading_zero; i < dem_size; i++) {
-                g = gcd(g, den[i]);
+                add_factor(den[i]);
             }
         }
 
-        auto new_num = std::vector<BigInt>();
+        auto new_num = V();
         new_num.reserve(num_size - leading_zero);
         for (auto i = 0; i + leading_zero < num_size; i++) {
             new_num.push_back(num[i + leading_zero] / g);
         }
-        auto new_den = std::vector<BigInt>();
+        auto new_den = V();
         new_den.reserve(dem_size - leading_zero);
         for (auto i = 0; i + leading_zero < dem_size; i++) {
             new_den.push_back(den[i + leading_zero] / g);
@@ -175,21 +290,30 @@ namespace number {
 
     Value::Value(const std::vector<BigInt>& num, const std::vector<BigInt>& den) {
         auto num_den = simplify(num, den);
+        assign(num_den.first, num_den.second);
+    }
 
-        m_numerator = std::move(num_den.first);
-        m_denominator = std::move(num_den.second);
+    Value::Value(std::span<const std::int64_t> num, std::span<const std::int64_t> den) {
+        auto num_den = simplify(Small(num.begin(), num.end()), Small(den.begin(), den.end()));
+        assign(num_den.first, num_den.second);
     }
 
     Value Value::clone() const {
-        auto v = Value(BigInt(0));
-        v.m_numerator = m_numerator;
-        v.m_denominator = m_denominator;
+        auto v = Value();
+        v.m_digits = m_digits;
+        v.m_terms = m_terms;
+        v.m_numerator_size = m_numerator_size;
+        v.m_enclosure = m_enclosure;
         return v;
     }
 
-    const std::vector<BigInt>& Value::get_numerator() const { return m_numerator; }
+    Coefficients Value::get_numerator() const {
+        return {m_digits, std::span(m_terms.data(), m_numerator_size)};
+    }
 
-    const std::vector<BigInt>& Value::get_denominator() const { return m_denominator; }
+    Coefficients Value::get_denominator() const {
+        return {m_digits, std::span(m_terms.data(), m_terms.size()).subspan(m_numerator_size)};
+    }
 
     std::optional<BigInt> get_ratio(const BigInt& x, const BigInt& y) {
         if (y == 0 || x % y != 0) {
@@ -199,14 +323,17 @@ namespace number {
     }
 
     std::optional<BigInt> Value::div_pi() const {
-        const auto& num = get_numerator();
-        const auto& den = get_denominator();
+        auto num = get_numerator();
+        auto den = get_denominator();
         if (num.empty()) {
             return 0;
         }
-        if (num[0] != 0 || num.size() != den.size() + 1) {
+        if (!num.is_zero(0) || num.size() != den.size() + 1) {
             return std::nullopt;
         }
+        if (den.size() == 1 && !den.is_negative(0) && den.magnitude(0) == "1") {
+            return num[1];
+        }
 
         auto ratio = get_ratio(num.back(), den.back());
         if (!ratio) {
@@ -221,12 +348,12 @@ namespace number {
     }
 
     std::optional<std::string> Value::to_letters() const {
-        if (m_numerator.size() == 0) {
+        if (m_numerator_size == 0) {
             return std::nullopt;
         }
         std::stringstream ss{};
         BigInt base{1};
-        for (const auto& n : m_numerator) {
+        for (const auto& n : get_numerator()) {
             if (n % base != 0 || n / base > CHAR_MAX || n / base <= '\0') {
                 return std::nullopt;
             }
@@ -238,29 +365,34 @@ namespace number {
 
     std::string Value::to_string() const {
         std::stringstream ss{};
+        auto print = [&](const Coefficients& c) {
+            const auto* space = "";
+            for (auto i = 0; i < c.size(); i++) {
+                ss << space;
+                if (c.is_zero(i)) {
+                    ss << '0';
+                } else {
+                    ss << (c.is_negative(i) ? "-" : "") << c.magnitude(i);
+                }
+                space = " ";
+            }
+        };
         ss << "{";
-        const auto* space = "";
-        for (const auto& n : get_numerator()) {
-            ss << space << n;
-            space = " ";
-        }
+        print(get_numerator());
         ss << "}{";
-        space = "";
-        for (const auto& n : get_denominator()) {
-            ss << space << n;
-            space = " ";
-        }
+        print(get_denominator());
         ss << "}";
         return ss.str();
     }
 
-    bool Value::to_bool() const { return !get_numerator().empty(); }
+    bool Value::to_bool() const { return m_numerator_size != 0; }
 
-    std::vector<BigInt> operator*(const std::vector<BigInt>& lhs, const std::vector<BigInt>& rhs) {
+    template <typename V> V multiply(const V& lhs, const V& rhs) {
+        auto result = V();
         if (lhs.empty() || rhs.empty()) {
-            return {};
+            return result;
         }
-        auto result = std::vector<BigInt>(lhs.size() + rhs.size() - 1, 0);
+        result.resize(lhs.size() + rhs.size() - 1, 0);
         for (auto i = 0; i < lhs.size(); i++) {
             for (auto j = 0; j < rhs.size(); j++) {
                 result[i + j] += lhs[i] * rhs[j];
@@ -269,6 +401,10 @@ namespace number {
         return result;
     }
 
+    std::vector<BigInt> operator*(const std::vector<BigInt>& lhs, const std::vector<BigInt>& rhs) {
+        return multiply(lhs, rhs);
+    }
+
     std::vector<BigInt> operator-(const std::vector<BigInt>& lhs, const std::vector<BigInt>& rhs) {
         auto result = std::vector<BigInt>(std::max(lhs.size(), rhs.size()), 0);
         for (auto i = 0; i < result.size(); i++) {
@@ -282,10 +418,9 @@ namespace number {
         return result;
     }
 
-    std::vector<BigInt> plus(const std::vector<BigInt>& x, const std::vector<BigInt>& y,
-                             bool positive) {
+    template <typename V> V plus(const V& x, const V& y, bool positive) {
         auto size = std::max(x.size(), y.size());
-        auto result = std::vector<BigInt>(size, 0);
+        auto result = V(size, 0);
         for (auto i = 0; i < size; i++) {
             if (i < x.size()) {
                 result[i] += x[i];
@@ -301,32 +436,71 @@ namespace number {
         return result;
     }
 
-    Value operator+(const Value& lhs, const Value& rhs) {
-        auto lhs_n = lhs.get_numerator() * rhs.get_denominator();
-        auto rhs_n = rhs.get_numerator() * lhs.get_denominator();
-        auto den = rhs.get_denominator() * lhs.get_denominator();
-        auto num = number::plus(lhs_n, rhs_n, true);
+    // Sets `small` to `c` as machine integers, if it's within the bounds of Small.
+    bool to_small(const Coefficients& c, Small& small) {
+        if (c.size() > SMALL_TERMS) {
+            return false;
+        }
+        for (auto i = 0; i < c.size(); i++) {
+            auto magnitude = c.magnitude(i);
+            if (magnitude.size() > SMALL_DIGITS) {
+                return false;
+            }
+            auto n = std::int64_t{0};
+            std::from_chars(magnitude.data(), magnitude.data() + magnitude.size(), n);
+            small.push_back(c.is_negative(i) ? -n : n);
+        }
+        return true;
+    }
+
+    // Calls `f` with the numerator and denominator of `lhs` and then `rhs`, as Small when they
+    // all fit, and as BigInts otherwise.
+    template <typename F> auto with_terms(const Value& lhs, const Value& rhs, F f) {
+        auto ln = Small();
+        auto ld = Small();
+        auto rn = Small();
+        auto rd = Small();
+        if (to_small(lhs.get_numerator(), ln) && to_small(lhs.get_denominator(), ld) &&
+            to_small(rhs.get_numerator(), rn) && to_small(rhs.get_denominator(), rd)) {
+            return f(ln, ld, rn, rd);
+        }
+        return f(lhs.get_numerator().to_vector(), lhs.get_denominator().to_vector(),
+                 rhs.get_numerator().to_vector(), rhs.get_denominator().to_vector());
+    }
+
+    Value make_value(const Small& num, const Small& den) {
+        return Value(std::span(num.data(), num.size()), std::span(den.data(), den.size()));
+    }
+    Value make_value(const std::vector<BigInt>& num, const std::vector<BigInt>& den) {
         return Value(num, den);
     }
 
+    Value operator+(const Value& lhs, const Value& rhs) {
+        return with_terms(lhs, rhs, [](const auto& ln, const auto& ld, const auto& rn,
+                                       const auto& rd) {
+            return make_value(plus(multiply(ln, rd), multiply(rn, ld), true), multiply(rd, ld));
+        });
+    }
+
     Value operator-(const Value& lhs, const Value& rhs) {
-        auto lhs_n = lhs.get_numerator() * rhs.get_denominator();
-        auto rhs_n = rhs.get_numerator() * lhs.get_denominator();
-        auto den = rhs.get_denominator() * lhs.get_denominator();
-        auto num = number::plus(lhs_n, rhs_n, false);
-        return Value(num, den);
+        return with_terms(lhs, rhs, [](const auto& ln, const auto& ld, const auto& rn,
+                                       const auto& rd) {
+            return make_value(plus(multiply(ln, rd), multiply(rn, ld), false), multiply(rd, ld));
+        });
     }
 
     Value operator*(const Value& lhs, const Value& rhs) {
-        auto num = lhs.get_numerator() * rhs.get_numerator();
-        auto den = lhs.get_denominator() * rhs.get_denominator();
-        return Value(num, den);
+        return with_terms(lhs, rhs, [](const auto& ln, const auto& ld, const auto& rn,
+                                       const auto& rd) {
+            return make_value(multiply(ln, rn), multiply(ld, rd));
+        });
     }
 
     Value operator/(const Value& lhs, const Value& rhs) {
-        auto num = lhs.get_numerator() * rhs.get_denominator();
-        auto den = lhs.get_denominator() * rhs.get_numerator();
-        return Value(num, den);
+        return with_terms(lhs, rhs, [](const auto& ln, const auto& ld, const auto& rn,
+                                       const auto& rd) {
+            return make_value(multiply(ln, rd), multiply(ld, rn));
+        });
     }
 
     Value from_bool(bool b) {
@@ -346,138 +520,262 @@ namespace number {
     }
 
     bool equal(const Value& lhs, const Value& rhs) {
-        auto lhs_n = lhs.get_numerator() * rhs.get_denominator();
-        auto rhs_n = rhs.get_numerator() * lhs.get_denominator();
-
-        auto degree = std::max(lhs_n.size(), rhs_n.size());
-
-        for (auto i = 1; i <= degree; i++) {
-            auto lhs = BigInt(0);
-            if (i < lhs_n.size()) {
-                lhs = lhs_n[i];
-            }
-            auto rhs = BigInt(0);
-            if (i < rhs_n.size()) {
-                rhs = rhs_n[i];
-            }
-            if (rhs != lhs) {
-                return false;
+        auto lhs_den = lhs.get_denominator();
+        auto rhs_den = rhs.get_denominator();
+        if (lhs_den.size() == 1 && rhs_den.size() == 1 && lhs_den.term_equal(0, rhs_den, 0)) {
+            // Same constant denominator, so the cross products are equal exactly when the
+            // numerators are, and the coefficients can be compared digit by digit.
+            auto lhs_num = lhs.get_numerator();
+            auto rhs_num = rhs.get_numerator();
+            auto degree = std::max(lhs_num.size(), rhs_num.size());
+            for (auto i = 1; i < degree; i++) {
+                auto lhs_zero = i >= lhs_num.size() || lhs_num.is_zero(i);
+                auto rhs_zero = i >= rhs_num.size() || rhs_num.is_zero(i);
+                if (lhs_zero != rhs_zero) {
+                    return false;
+                }
+                if (!lhs_zero && !lhs_num.term_equal(i, rhs_num, i)) {
+                    return false;
+                }
             }
+            return true;
         }
-        return true;
+
+        return with_terms(lhs, rhs, [](const auto& ln, const auto& ld, const auto& rn,
+                                       const auto& rd) {
+            auto lhs_n = multiply(ln, rd);
+            auto rhs_n = multiply(rn, ld);
+            auto degree = std::max(lhs_n.size(), rhs_n.size());
+            for (auto i = 1; i < degree; i++) {
+                auto lhs_zero = i >= lhs_n.size() || lhs_n[i] == 0;
+                auto rhs_zero = i >= rhs_n.size() || rhs_n[i] == 0;
+                if (lhs_zero != rhs_zero || (!lhs_zero && lhs_n[i] != rhs_n[i])) {
+                    return false;
+                }
+            }
+            return true;
+        });
     }
 
     Value operator==(const Value& lhs, const Value& rhs) { return from_bool(equal(lhs, rhs)); }
 
     Value operator!=(const Value& lhs, const Value& rhs) { return from_bool(!equal(lhs, rhs)); }
 
-    std::pair<BigInt, BigInt> evaluate_with_margin(const std::vector<BigInt>& v, int sf) {
-        assert(sf > 0 && sf <= PI_DIGITS);
-        auto result = std::make_pair(BigInt(0), BigInt(0));
-        auto pi = BigInt(std::string(PI, PI + sf));
-        auto ten = big_pow10(sf - 1);
-        auto acc = ten;
-        auto add_margin = [&](const BigInt& e, const BigInt& acc) {
-            if (e < 0) {
-                result.first += e * (acc + 1);
-                result.second += e * acc;
-            } else if (e > 0) {
-                result.first += e * acc;
-                result.second += e * (acc + 1);
+    // The numerator and denominator of a Value evaluated at an enclosure of pi with `bits`
+    // fractional bits.
+    struct Enclosure {
+        int bits;
+        // The coefficients of the numerator followed by the denominator, converted once and
+        // carried over to finer enclosures.
+        std::shared_ptr<const std::vector<ball::Int>> coefficients;
+        ball::Ball numerator;
+        ball::Ball denominator;
+    };
+
+    const Enclosure& Value::enclose(int bits) const {
+        if (m_enclosure && m_enclosure->bits >= bits) {
+            return *m_enclosure;
+        }
+        auto coefficients = m_enclosure ? m_enclosure->coefficients : nullptr;
+        if (!coefficients) {
+            auto c = std::vector<ball::Int>();
+            c.reserve(m_terms.size());
+            for (auto i = 0; i < m_terms.size(); i++) {
+                c.push_back(ball::from_decimal(
+                    std::string_view(m_digits).substr(m_terms[i].offset, m_terms[i].length),
+                    m_terms[i].negative));
             }
-        };
-        if (!v.empty()) {
-            add_margin(v[0], acc);
+            coefficients = std::make_shared<const std::vector<ball::Int>>(std::move(c));
+        }
+        auto all = std::span(*coefficients);
+        m_enclosure = std::make_shared<const Enclosure>(Enclosure{
+            .bits{bits},
+            .coefficients{coefficients},
+            .numerator{ball::evaluate(all.first(m_numerator_size), bits)},
+            .denominator{ball::evaluate(all.subspan(m_numerator_size), bits)},
+        });
+        return *m_enclosure;
+    }
+
+    std::optional<bool> less_than(const Value& lhs, const Value& rhs, int bits) {
+        // Each side may come back at a finer precision than asked for, but both cross products
+        // below still end up with the same number of fractional bits.
+        const auto& l = lhs.enclose(bits);
+        const auto& r = rhs.enclose(bits);
+
+        // lhs - rhs has the sign of (ln * rd - rn * ld) * ld * rd.
+        auto den_sign = ball::sign(l.denominator);
+        if (!den_sign) {
+            return std::nullopt;
         }
-        for (auto i = 1; i < v.size(); i++) {
-            acc *= pi;
-            acc /= ten;
-            add_margin(v[i], acc);
+        auto rhs_den_sign = ball::sign(r.denominator);
+        if (!rhs_den_sign) {
+            return std::nullopt;
         }
-        return result;
+        auto diff_sign = ball::sign(l.numerator * r.denominator - r.numerator * l.denominator);
+        if (!diff_sign) {
+            return std::nullopt;
+        }
+        return *diff_sign * *den_sign * *rhs_den_sign < 0;
     }
 
-    BigInt evaluate(const std::vector<BigInt>& v, int sf) {
-        assert(sf > 0 && sf <= PI_DIGITS);
-        auto result = BigInt(0);
-        auto pi = BigInt(std::string(PI, PI + sf));
-        auto ten = big_pow10(sf - 1);
-        auto acc = ten;
-        if (!v.empty()) {
-            result += v[0] * acc;
+    // v(pi) in double precision together with a bound on its absolute error, or nullopt if it
+    // doesn't fit in a double.
+    std::optional<std::pair<double, double>> approximate(const Coefficients& v) {
+        static auto pi_powers = std::vector<double>{1};
+        auto sum = 0.0;
+        auto abs_sum = 0.0;
+        for (auto i = 0; i < v.size(); i++) {
+            if (v.is_zero(i)) {
+                continue;
+            }
+            auto magnitude = v.magnitude(i);
+            auto c = 0.0;
+            auto [_, ec] =
+                std::from_chars(magnitude.data(), magnitude.data() + magnitude.size(), c);
+            if (ec != std::errc()) {
+                return std::nullopt;
+            }
+            while (pi_powers.size() <= i) {
+                pi_powers.push_back(pi_powers.back() * std::numbers::pi);
+            }
+            auto term = c * pi_powers[i];
+            sum += v.is_negative(i) ? -term : term;
+            abs_sum += term;
         }
-        for (auto i = 1; i < v.size(); i++) {
-            acc *= pi;
-            acc /= ten;
-            result += v[i] * acc;
+        if (!std::isfinite(abs_sum)) {
+            return std::nullopt;
         }
-        return result;
-    }
-
-    std::optional<bool> less_than(const Value& lhs, const Value& rhs, int sf) {
-        using Range = std::pair<BigInt, BigInt>;
-        auto eval = [&sf](const Value& hs) -> std::optional<std::pair<Range, Range>> {
-            auto hs_n = evaluate_with_margin(hs.get_numerator(), sf);
-            auto hs_d = evaluate_with_margin(hs.get_denominator(), sf);
-            if ((hs_n.first < 0 && hs_n.second > 0) || (hs_d.first < 0 && hs_d.second > 0)) {
+        // Parsing a coefficient and each multiplication building pi^i round once, and so does
+        // every addition, so each term carries a relative error of at most (3n + 3)u. Twice that
+        // leaves room for the rounding of the bound itself.
+        auto u = std::numeric_limits<double>::epsilon() / 2;
+        auto error = abs_sum * 2 * (3 * static_cast<double>(v.size()) + 3) * u;
+        return std::make_pair(sum, error);
+    }
+
+    // Decides lhs < rhs in double precision when the two values are clearly apart, so that only
+    // close calls pay for BigInt interval arithmetic.
+    std::optional<bool> less_than_filter(const Value& lhs, const Value& rhs) {
+        // An interval around the value of the fraction.
+        auto eval = [](const Value& hs) -> std::optional<std::pair<double, double>> {
+            auto n = approximate(hs.get_numerator());
+            auto d = approximate(hs.get_denominator());
+            if (!n || !d || std::abs(d->first) <= d->second) {
                 return std::nullopt;
             }
-            if (hs_d.first < 0) {
-                auto first = std::move(hs_n.first);
-                hs_n.first = -hs_n.second;
-                hs_n.second = -first;
-                first = std::move(hs_d.first);
-                hs_d.first = -hs_d.second;
-                hs_d.second = -first;
+            if (n->first == 0 && n->second == 0) {
+                return std::make_pair(0.0, 0.0);
             }
-            return std::make_pair(hs_n, hs_d);
+            if (std::abs(n->first) <= n->second) {
+                return std::nullopt;
+            }
+            auto rn = n->second / std::abs(n->first);
+            auto rd = d->second / std::abs(d->first);
+            if (rd >= 0.5) {
+                return std::nullopt;
+            }
+            // The relative error of n / d, plus the rounding of the division, doubled so that
+            // the additions comparing the intervals below can't round across each other.
+            auto u = std::numeric_limits<double>::epsilon() / 2;
+            auto q = n->first / d->first;
+            return std::make_pair(q, std::abs(q) * 2 * ((rn + rd) / (1 - rd) + 2 * u));
         };
 
         auto l = eval(lhs);
         if (!l) {
             return std::nullopt;
         }
-        auto lhs_n = l->first;
-        auto lhs_d = l->second;
-
         auto r = eval(rhs);
         if (!r) {
             return std::nullopt;
         }
-        auto rhs_n = r->first;
-        auto rhs_d = r->second;
-
-        auto get_nd = [](const Range& n, const Range& d) {
-            return n.first >= 0 ? std::make_pair(n.first * d.first, //
-                                                 n.second * d.second)
-                                : std::make_pair(n.first * d.second, //
-                                                 n.second * d.first);
-        };
-
-        auto lhs_nd = get_nd(lhs_n, rhs_d);
-        auto rhs_nd = get_nd(rhs_n, lhs_d);
-
-        if (lhs_nd.second < rhs_nd.first) {
+        if (l->first + l->second < r->first - r->second) {
             return true;
         }
-        if (rhs_nd.second < lhs_nd.first) {
+        if (r->first + r->second < l->first - l->second) {
             return false;
         }
-
         return std::nullopt;
     }
 
+    // The highest precision tried with ball arithmetic. Rounding error grows with the
+    // coefficients, so past this the root isolation in less_than_exact needs fewer digits of pi.
+    const int BALL_BITS = 1024;
+
+    // Where comparisons between values of one shape start. Repeated comparisons, such as a loop
+    // condition, skip the precisions that failed last time.
+    struct Start {
+        // The precision that last decided one, past BALL_BITS if only the exact one could.
+        int bits{0};
+        unsigned calls{0};
+    };
+    // Values of a shape vary, so now and then a comparison starts from the lowest precision
+    // again, or one hard case would slow its shape for good.
+    const unsigned RESTART_EVERY = 8;
+
+    // The sizes of the numerator and denominator of either side, the smaller side first since
+    // x > y compares y < x. Each shape has a Start of its own, so no other shape can move it.
+    using Shape = std::array<std::size_t, 4>;
+
+    Start& start_bits(const Value& lhs, const Value& rhs) {
+        static auto table = std::map<Shape, Start>();
+        auto l = std::pair(lhs.get_numerator().size(), lhs.get_denominator().size());
+        auto r = std::pair(rhs.get_numerator().size(), rhs.get_denominator().size());
+        if (r < l) {
+            std::swap(l, r);
+        }
+        return table[Shape{l.first, l.second, r.first, r.second}];
+    }
+
+    // Decides lhs < rhs from the exact signs of the polynomials in pi behind it, for values too
+    // close for a few rounds of ball arithmetic.
+    std::optional<bool> less_than_exact(const Value& lhs, const Value& rhs) {
+        // Any precision will do, only the exact coefficients are needed.
+        auto polynomials = [](const Value& v) {
+            auto all = std::span(*v.enclose(0).coefficients);
+            auto numerator_size = v.get_numerator().size();
+            return std::pair(all.first(numerator_size), all.subspan(numerator_size));
+        };
+        auto [ln, ld] = polynomials(lhs);
+        auto [rn, rd] = polynomials(rhs);
+
+        auto den_sign = roots::sign_at_pi(ld);
+        if (!den_sign || *den_sign == 0) {
+            return std::nullopt;
+        }
+        auto rhs_den_sign = roots::sign_at_pi(rd);
+        if (!rhs_den_sign || *rhs_den_sign == 0) {
+            return std::nullopt;
+        }
+        auto diff_sign =
+            roots::sign_at_pi(roots::subtract(roots::multiply(ln, rd), roots::multiply(rn, ld)));
+        if (!diff_sign) {
+            return std::nullopt;
+        }
+        return *diff_sign * *den_sign * *rhs_den_sign < 0;
+    }
+
     bool less_than(const Value& lhs, const Value& rhs) {
         if (equal(lhs, rhs)) {
             return false;
         }
-        auto sf = 8;
-        while (sf <= PI_DIGITS) {
-            auto lt = less_than(lhs, rhs, sf);
+        if (auto lt = less_than_filter(lhs, rhs)) {
+            return *lt;
+        }
+        auto& start = start_bits(lhs, rhs);
+        auto first = ++start.calls % RESTART_EVERY == 0 ? 0 : start.bits;
+        for (auto bits = std::max(first, 32); bits <= BALL_BITS; bits *= 2) {
+            auto lt = less_than(lhs, rhs, bits);
             if (lt) {
+                start.bits = bits;
                 return *lt;
             }
-            sf *= 2;
+        }
+        // Past BALL_BITS, so the next comparisons of this shape go straight to the exact one.
+        start.bits = BALL_BITS * 2;
+        if (auto lt = less_than_exact(lhs, rhs)) {
+            return *lt;
         }
         std::cerr << "Not enough pi digits to figure out which if " << lhs.to_string() << " < "
                   << rhs.to_string() << '\n';
@@ -508,7 +806,7 @@ namespace number {
 
     Value operator!(const Value& lhs) { return from_bool(!lhs.to_bool()); }
 
-    BigInt substitute(const std::vector<BigInt>& v, const BigInt& pi) {
+    BigInt substitute(const Coefficients& v, const BigInt& pi) {
         auto result = BigInt(0);
         auto acc = BigInt(1);
         if (!v.empty()) {
@@ -532,7 +830,12 @@ namespace number {
             num = -num;
             den = -den;
         }
-        num %= den * length * pi;
+        // Reduced into [0, modulus), so that indices on either side of zero hash alike.
+        auto modulus = den * length * pi;
+        num %= modulus;
+        if (num < 0) {
+            num += modulus;
+        }
         auto hasher = std::hash<std::string>();
         return hasher(num.to_string()) ^ hasher(den.to_string());
     }
@@ -573,12 +876,11 @@ namespace number {
 
     std::size_t Index::hash() const { return m_hash; }
 
-    bool Index::operator==(const Index& rhs) const {
-        assert(m_length == rhs.m_length);
-        const auto& lhs_num = get_const_ref(m_value).get_numerator();
-        const auto& rhs_num = get_const_ref(rhs.m_value).get_numerator();
-        const auto& lhs_den = get_const_ref(m_value).get_denominator();
-        const auto& rhs_den = get_const_ref(rhs.m_value).get_denominator();
+    bool index_equal(const Value& lhs, const Value& rhs, int length) {
+        auto lhs_num = lhs.get_numerator().to_vector();
+        auto rhs_num = rhs.get_numerator().to_vector();
+        auto lhs_den = lhs.get_denominator().to_vector();
+        auto rhs_den = rhs.get_denominator().to_vector();
         auto lhs_nd = lhs_num * rhs_den;
         auto rhs_nd = rhs_num * lhs_den;
         auto den = lhs_den * rhs_den;
@@ -598,17 +900,22 @@ namespace number {
         if (diff.size() != den.size() + 1) {
             return false;
         }
-        auto ratio = get_ratio(diff.back(), den.back() * m_length);
+        auto ratio = get_ratio(diff.back(), den.back() * length);
         if (!ratio) {
             return false;
         }
         for (int i = 0; i < den.size() - 1; i++) {
-            if (ratio != get_ratio(diff[i + 1], den[i] * m_length)) {
+            if (ratio != get_ratio(diff[i + 1], den[i] * length)) {
                 return false;
             }
         }
         return true;
     }
+
+    bool Index::operator==(const Index& rhs) const {
+        assert(m_length == rhs.m_length);
+        return index_equal(get_value(), rhs.get_value(), m_length);
+    }
 } // namespace number
 
 std::size_t std::hash<number::Index>::operator()(const number::Index& i) const noexcept {
@@ -2,7 +2,12 @@
 
 #include "macros.hpp"
 #include "vendor/BigInt.hpp"
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <span>
 #include <string_view>
 #include <tl/expected.hpp>
 #include <vector>
@@ -32,11 +37,84 @@ namespace number {
 
     constexpr int LETTER_BASE{256};
 
+    // The coefficients of a polynomial in pi, viewed in place inside the buffer of a Value.
+    class Coefficients {
+      public:
+        struct Term {
+            std::uint32_t offset;
+            // Zero coefficients have no digits.
+            std::uint32_t length;
+            bool negative;
+        };
+
+      private:
+        std::string_view m_digits;
+        std::span<const Term> m_terms;
+
+      public:
+        Coefficients(std::string_view digits, std::span<const Term> terms);
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] BigInt operator[](std::size_t i) const;
+        [[nodiscard]] BigInt back() const;
+        [[nodiscard]] std::string_view magnitude(std::size_t i) const;
+        [[nodiscard]] bool is_zero(std::size_t i) const;
+        [[nodiscard]] bool is_negative(std::size_t i) const;
+        [[nodiscard]] bool term_equal(std::size_t i, const Coefficients& rhs, std::size_t j) const;
+        [[nodiscard]] std::vector<BigInt> to_vector() const;
+
+        class Iterator {
+          private:
+            const Coefficients* m_c{};
+            std::size_t m_index{};
+
+          public:
+            Iterator() = default;
+            Iterator(const Coefficients& c, std::size_t index) : m_c{&c}, m_index{index} {}
+
+            using value_type = BigInt;              // NOLINT(readability-identifier-naming)
+            using difference_type = std::ptrdiff_t; // NOLINT(readability-identifier-naming)
+
+            BigInt operator*() const { return (*m_c)[m_index]; }
+
+            Iterator& operator++() {
+                m_index++;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto tmp = *this;
+                m_index++;
+                return tmp;
+            }
+
+            bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index; }
+        };
+        static_assert(std::input_iterator<Iterator>);
+
+        [[nodiscard]] Iterator begin() const { return {*this, 0}; }
+        [[nodiscard]] Iterator end() const { return {*this, size()}; }
+    };
+
+    bool operator==(const Coefficients& lhs, const std::vector<BigInt>& rhs);
+
+    struct Enclosure;
+
     class Value {
       private:
         // Invariant: The fraction will always be simplified with simplify().
-        std::vector<BigInt> m_numerator;
-        std::vector<BigInt> m_denominator;
+        // The decimal magnitudes of every coefficient, numerator first, share one buffer so that
+        // walking a fraction doesn't chase a heap pointer per coefficient.
+        std::string m_digits;
+        boost::container::small_vector<Coefficients::Term, 3> m_terms;
+        std::uint32_t m_numerator_size{};
+        // The finest enclosure computed so far. It is immutable, so clones share it.
+        mutable std::shared_ptr<const Enclosure> m_enclosure;
+
+        Value() = default;
+        // From simplified coefficients, either BigInts or machine integers.
+        template <typename V> void assign(const V& num, const V& den);
 
       public:
         NON_COPIABLE(Value)
@@ -44,14 +122,20 @@ namespace number {
         explicit Value(std::string_view letters);
         explicit Value(const BigInt& number);
         explicit Value(const std::vector<BigInt>& num, const std::vector<BigInt>& den);
+        // The same for coefficients that fit in machine integers, which skips the BigInts.
+        explicit Value(std::span<const std::int64_t> num, std::span<const std::int64_t> den);
         [[nodiscard]] Value clone() const;
 
-        [[nodiscard]] const std::vector<BigInt>& get_numerator() const;
-        [[nodiscard]] const std::vector<BigInt>& get_denominator() const;
+        [[nodiscard]] Coefficients get_numerator() const;
+        [[nodiscard]] Coefficients get_denominator() const;
         [[nodiscard]] std::optional<BigInt> div_pi() const;
         [[nodiscard]] std::optional<std::string> to_letters() const;
         [[nodiscard]] std::string to_string() const;
         [[nodiscard]] bool to_bool() const;
+
+        // An enclosure with at least `bits` fractional bits, reusing the cached one when it is
+        // already fine enough.
+        [[nodiscard]] const Enclosure& enclose(int bits) const;
     };
 
     [[nodiscard]] bool equal(const Value& lhs, const Value& rhs);
@@ -70,6 +154,11 @@ namespace number {
     [[nodiscard]] Value operator>=(const Value& lhs, const Value& rhs);
     [[nodiscard]] Value operator!(const Value& lhs);
 
+    // Indices of a circular array with `length` elements are equal when they differ by a multiple
+    // of length * pi, and so are their hashes.
+    [[nodiscard]] std::size_t hash(const Value& value, int length);
+    [[nodiscard]] bool index_equal(const Value& lhs, const Value& rhs, int length);
+
     class Index {
         // An index of a circular array
       private:
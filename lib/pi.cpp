@@ -1,702 +1,159 @@
 #include "pi.hpp"
 
-// 65536 digits of pi
-const char* const PI =
-    "3141592653589793238462643383279502884197169399375105820974944592307816406286208998628034825342"
-    "1170679821480865132823066470938446095505822317253594081284811174502841027019385211055596446229"
-    "4895493038196442881097566593344612847564823378678316527120190914564856692346034861045432664821"
-    "3393607260249141273724587006606315588174881520920962829254091715364367892590360011330530548820"
-    "4665213841469519415116094330572703657595919530921861173819326117931051185480744623799627495673"
-    "5188575272489122793818301194912983367336244065664308602139494639522473719070217986094370277053"
-    "9217176293176752384674818467669405132000568127145263560827785771342757789609173637178721468440"
-    "9012249534301465495853710507922796892589235420199561121290219608640344181598136297747713099605"
-    "1870721134999999837297804995105973173281609631859502445945534690830264252230825334468503526193"
-    "1188171010003137838752886587533208381420617177669147303598253490428755468731159562863882353787"
-    "5937519577818577805321712268066130019278766111959092164201989380952572010654858632788659361533"
-    "8182796823030195203530185296899577362259941389124972177528347913151557485724245415069595082953"
-    "3116861727855889075098381754637464939319255060400927701671139009848824012858361603563707660104"
-    "7101819429555961989467678374494482553797747268471040475346462080466842590694912933136770289891"
-    "5210475216205696602405803815019351125338243003558764024749647326391419927260426992279678235478"
-    "1636009341721641219924586315030286182974555706749838505494588586926995690927210797509302955321"
-    "1653449872027559602364806654991198818347977535663698074265425278625518184175746728909777727938"
-    "0008164706001614524919217321721477235014144197356854816136115735255213347574184946843852332390"
-    "7394143334547762416862518983569485562099219222184272550254256887671790494601653466804988627232"
-    "7917860857843838279679766814541009538837863609506800642251252051173929848960841284886269456042"
-    "4196528502221066118630674427862203919494504712371378696095636437191728746776465757396241389086"
-    "5832645995813390478027590099465764078951269468398352595709825822620522489407726719478268482601"
-    "4769909026401363944374553050682034962524517493996514314298091906592509372216964615157098583874"
-    "1059788595977297549893016175392846813826868386894277415599185592524595395943104997252468084598"
-    "7273644695848653836736222626099124608051243884390451244136549762780797715691435997700129616089"
-    "4416948685558484063534220722258284886481584560285060168427394522674676788952521385225499546667"
-    "2782398645659611635488623057745649803559363456817432411251507606947945109659609402522887971089"
-    "3145669136867228748940560101503308617928680920874760917824938589009714909675985261365549781893"
-    "1297848216829989487226588048575640142704775551323796414515237462343645428584447952658678210511"
-    "4135473573952311342716610213596953623144295248493718711014576540359027993440374200731057853906"
-    "2198387447808478489683321445713868751943506430218453191048481005370614680674919278191197939952"
-    "0614196634287544406437451237181921799983910159195618146751426912397489409071864942319615679452"
-    "0809514655022523160388193014209376213785595663893778708303906979207734672218256259966150142150"
-    "3068038447734549202605414665925201497442850732518666002132434088190710486331734649651453905796"
-    "2685610055081066587969981635747363840525714591028970641401109712062804390397595156771577004203"
-    "3786993600723055876317635942187312514712053292819182618612586732157919841484882916447060957527"
-    "0695722091756711672291098169091528017350671274858322287183520935396572512108357915136988209144"
-    "4210067510334671103141267111369908658516398315019701651511685171437657618351556508849099898599"
-    "8238734552833163550764791853589322618548963213293308985706420467525907091548141654985946163718"
-    "0270981994309924488957571282890592323326097299712084433573265489382391193259746366730583604142"
-    "8138830320382490375898524374417029132765618093773444030707469211201913020330380197621101100449"
-    "2932151608424448596376698389522868478312355265821314495768572624334418930396864262434107732269"
-    "7802807318915441101044682325271620105265227211166039666557309254711055785376346682065310989652"
-    "6918620564769312570586356620185581007293606598764861179104533488503461136576867532494416680396"
-    "2657978771855608455296541266540853061434443185867697514566140680070023787765913440171274947042"
-    "0562230538994561314071127000407854733269939081454664645880797270826683063432858785698305235808"
-    "9330657574067954571637752542021149557615814002501262285941302164715509792592309907965473761255"
-    "1765675135751782966645477917450112996148903046399471329621073404375189573596145890193897131117"
-    "9042978285647503203198691514028708085990480109412147221317947647772622414254854540332157185306"
-    "1422881375850430633217518297986622371721591607716692547487389866549494501146540628433663937900"
-    "3976926567214638530673609657120918076383271664162748888007869256029022847210403172118608204190"
-    "0042296617119637792133757511495950156604963186294726547364252308177036751590673502350728354056"
-    "7040386743513622224771589150495309844489333096340878076932599397805419341447377441842631298608"
-    "0998886874132604721569516239658645730216315981931951673538129741677294786724229246543668009806"
-    "7692823828068996400482435403701416314965897940924323789690706977942236250822168895738379862300"
-    "1593776471651228935786015881617557829735233446042815126272037343146531977774160319906655418763"
-    "9792933441952154134189948544473456738316249934191318148092777710386387734317720754565453220777"
-    "0921201905166096280490926360197598828161332316663652861932668633606273567630354477628035045077"
-    "7235547105859548702790814356240145171806246436267945612753181340783303362542327839449753824372"
-    "0583531147711992606381334677687969597030983391307710987040859133746414428227726346594704745878"
-    "4778720192771528073176790770715721344473060570073349243693113835049316312840425121925651798069"
-    "4113528013147013047816437885185290928545201165839341965621349143415956258658655705526904965209"
-    "8580338507224264829397285847831630577775606888764462482468579260395352773480304802900587607582"
-    "5104747091643961362676044925627420420832085661190625454337213153595845068772460290161876679524"
-    "0616342522577195429162991930645537799140373404328752628889639958794757291746426357455254079091"
-    "4513571113694109119393251910760208252026187985318877058429725916778131496990090192116971737278"
-    "4768472686084900337702424291651300500516832336435038951702989392233451722013812806965011784408"
-    "7451960121228599371623130171144484640903890644954440061986907548516026327505298349187407866808"
-    "8183385102283345085048608250393021332197155184306354550076682829493041377655279397517546139539"
-    "8468339363830474611996653858153842056853386218672523340283087112328278921250771262946322956398"
-    "9898935821167456270102183564622013496715188190973038119800497340723961036854066431939509790190"
-    "6996395524530054505806855019567302292191393391856803449039820595510022635353619204199474553859"
-    "3810234395544959778377902374216172711172364343543947822181852862408514006660443325888569867054"
-    "3154706965747458550332323342107301545940516553790686627333799585115625784322988273723198987571"
-    "4159578111963583300594087306812160287649628674460477464915995054973742562690104903778198683593"
-    "8146574126804925648798556145372347867330390468838343634655379498641927056387293174872332083760"
-    "1123029911367938627089438799362016295154133714248928307220126901475466847653576164773794675200"
-    "4907571555278196536213239264061601363581559074220202031872776052772190055614842555187925303435"
-    "1398442532234157623361064250639049750086562710953591946589751413103482276930624743536325691607"
-    "8154781811528436679570611086153315044521274739245449454236828860613408414863776700961207151249"
-    "1404302725386076482363414334623518975766452164137679690314950191085759844239198629164219399490"
-    "7236234646844117394032659184044378051333894525742399508296591228508555821572503107125701266830"
-    "2402929525220118726767562204154205161841634847565169998116141010029960783869092916030288400269"
-    "1041407928862150784245167090870006992821206604183718065355672525325675328612910424877618258297"
-    "6515795984703562226293486003415872298053498965022629174878820273420922224533985626476691490556"
-    "2842503912757710284027998066365825488926488025456610172967026640765590429099456815065265305371"
-    "8294127033693137851786090407086671149655834343476933857817113864558736781230145876871266034891"
-    "3909562009939361031029161615288138437909904231747336394804575931493140529763475748119356709110"
-    "1377517210080315590248530906692037671922033229094334676851422144773793937517034436619910403375"
-    "1117354719185504644902636551281622882446257591633303910722538374218214088350865739177150968288"
-    "7478265699599574490661758344137522397096834080053559849175417381883999446974867626551658276584"
-    "8358845314277568790029095170283529716344562129640435231176006651012412006597558512761785838292"
-    "0419748442360800719304576189323492292796501987518721272675079812554709589045563579212210333466"
-    "9749923563025494780249011419521238281530911407907386025152274299581807247162591668545133312394"
-    "8049470791191532673430282441860414263639548000448002670496248201792896476697583183271314251702"
-    "9692348896276684403232609275249603579964692565049368183609003238092934595889706953653494060340"
-    "2166544375589004563288225054525564056448246515187547119621844396582533754388569094113031509526"
-    "1793780029741207665147939425902989695946995565761218656196733786236256125216320862869222103274"
-    "8892186543648022967807057656151446320469279068212073883778142335628236089632080682224680122482"
-    "6117718589638140918390367367222088832151375560037279839400415297002878307667094447456013455641"
-    "7254370906979396122571429894671543578468788614445812314593571984922528471605049221242470141214"
-    "7805734551050080190869960330276347870810817545011930714122339086639383395294257869050764310063"
-    "8351983438934159613185434754649556978103829309716465143840700707360411237359984345225161050702"
-    "7056235266012764848308407611830130527932054274628654036036745328651057065874882256981579367897"
-    "6697422057505968344086973502014102067235850200724522563265134105592401902742162484391403599895"
-    "3539459094407046912091409387001264560016237428802109276457931065792295524988727584610126483699"
-    "9892256959688159205600101655256375678566722796619885782794848855834397518744545512965634434803"
-    "9664205579829368043522027709842942325330225763418070394769941597915945300697521482933665556615"
-    "6787364005366656416547321704390352132954352916941459904160875320186837937023488868947915107163"
-    "7852902345292440773659495630510074210871426134974595615138498713757047101787957310422969066670"
-    "2144986374645952808243694457897723300487647652413390759204340196340391147320233807150952220106"
-    "8256342747164602433544005152126693249341967397704159568375355516673027390074972973635496453328"
-    "8869844061196496162773449518273695588220757355176651589855190986665393549481068873206859907540"
-    "7923424023009259007017319603622547564789406475483466477604114632339056513433068449539790709030"
-    "2346046147096169688688501408347040546074295869913829668246818571031887906528703665083243197440"
-    "4771855678934823089431068287027228097362480939962706074726455399253994428081137369433887294063"
-    "0792615959954626246297070625948455690347119729964090894180595343932512362355081349490043642785"
-    "2713831591256898929519642728757394691427253436694153236100453730488198551706594121735246258954"
-    "8730167600298865925786628561249665523533829428785425340483083307016537228563559152534784459818"
-    "3134112900199920598135220511733658564078264849427644113763938669248031183644536985891754426473"
-    "9988228462184490087776977631279572267265556259628254276531830013407092233436577916012809317940"
-    "1718598599933849235495640057099558561134980252499066984233017350358044081168552653117099570899"
-    "4273287092584878944364600504108922669178352587078595129834417295351953788553457374260859029081"
-    "7651557803905946408735061232261120093731080485485263572282576820341605048466277504500312620080"
-    "0799804925485346941469775164932709504934639382432227188515974054702148289711177792376122578873"
-    "4771881968254629812686858170507402725502633290449762778944236216741191862694396506715157795867"
-    "5648239939176042601763387045499017614364120469218237076488783419689686118155815873606293860381"
-    "0171215855272668300823834046564758804051380801633638874216371406435495561868964112282140753302"
-    "6551004241048967835285882902436709048871181909094945331442182876618103100735477054981596807720"
-    "0947469613436092861484941785017180779306810854690009445899527942439813921350558642219648349151"
-    "2639012803832001097738680662877923971801461343244572640097374257007359210031541508936793008169"
-    "9805365202760072774967458400283624053460372634165542590276018348403068113818551059797056640075"
-    "0942608788573579603732451414678670368809880609716425849759513806930944940151542222194329130217"
-    "3912538355915031003330325111749156969174502714943315155885403922164097229101129035521815762823"
-    "2831823425483261119128009282525619020526301639114772473314857391077758744253876117465786711694"
-    "1477642144111126358355387136101102326798775641024682403226483464176636980663785768134920453022"
-    "4081972785647198396308781543221166912246415911776732253264335686146186545222681268872684459684"
-    "4241610785401676814208088502800541436131462308210259417375623899420757136275167457318918945628"
-    "3525704413354375857534269869947254703165661399199968262824727064133622217892390317608542894373"
-    "3935618891651250424404008952719837873864805847268954624388234375178852014395600571048119498842"
-    "3906061369573423155907967034614914344788636041031823507365027785908975782727313050488939890099"
-    "2391350337325085598265586708924261242947367019390772713070686917092646254842324074855036608013"
-    "6046689511840093668609546325002145852930950000907151058236267293264537382104938724996699339424"
-    "6855164832611341461106802674466373343753407642940266829738652209357016263846485285149036293201"
-    "9919968828517183953669134522244470804592396602817156551565666111359823112250628905854914509715"
-    "7553900243931535190902107119457300243880176615035270862602537881797519478061013715004489917210"
-    "0222013350131060163915415895780371177927752259787428919179155224171895853616805947412341933984"
-    "2021874564925644346239253195313510331147639491199507285843065836193536932969928983791494193940"
-    "6085724863968836903265564364216644257607914710869984315733749648835292769328220762947282381537"
-    "4099615455987982598910937171262182830258481123890119682214294576675807186538065064870261338928"
-    "2299497257453033283896381843944770779402284359883410035838542389735424395647555684095224844554"
-    "1392394100016207693636846776413017819659379971557468541946334893748439129742391433659360410035"
-    "2343777065888677811394986164787471407932638587386247328896456435987746676384794665040741118256"
-    "5837887845485814896296127399841344272608606187245545236064315371011274680977870446409475828034"
-    "8769758948328241239292960582948619196670918958089833201210318430340128495116203534280144127617"
-    "2858302435598300320420245120728725355811958401491809692533950757784000674655260314461670508276"
-    "8277222353419110263416315714740612385042584598841990761128725805911393568960143166828317632356"
-    "7325417073420817332230462987992804908514094790368878687894930546955703072619009502076433493359"
-    "1060245450864536289354568629585313153371838682656178622736371697577418302398600659148161640494"
-    "4965011732131389574706208847480236537103115089842799275442685327797431139514357417221975979935"
-    "9685252285745263796289612691572357986620573408375766873884266405990993505000813375432454635967"
-    "5048442352848747014435454195762584735642161981340734685411176688311865448937769795665172796623"
-    "2671481033864391375186594673002443450054499539974237232871249483470604406347160632583064982979"
-    "5510109541836235030309453097335834462839476304775645015008507578949548931393944899216125525597"
-    "7014368589435858775263796255970816776438001254365023714127834679261019955852247172201777237004"
-    "1780841942394872540680155603599839054898572354674564239058585021671903139526294455439131663134"
-    "5308939062046784387785054239390524731362012947691874975191011472315289326772533918146607300089"
-    "0277689631148109022097245207591672970078505807171863810549679731001678708506942070922329080703"
-    "8326345345203802786099055690013413718236837099194951648960075504934126787643674638490206396401"
-    "9766685592335654639138363185745698147196210841080961884605456039038455343729141446513474940784"
-    "8844237721751543342603066988317683310011331086904219390310801437843341513709243530136776310849"
-    "1351615642269847507430329716746964066653152703532546711266752246055119958183196376370761799191"
-    "9203579582007595605302346267757943936307463056901080114942714100939136913810725813781357894005"
-    "5995001835425118417213605572752210352680373572652792241737360575112788721819084490061780138897"
-    "1077082293100279766593583875890939568814856026322439372656247277603789081445883785501970284377"
-    "9362407825052704875816470324581290878395232453237896029841669225489649715606981192186584926770"
-    "4039564812781021799132174163058105545988013004845629976511212415363745150056350701278159267142"
-    "4134210330156616535602473380784302865525722275304999883701534879300806260180962381516136690334"
-    "1111386538510919367393835229345888322550887064507539473952043968079067086806445096986548801682"
-    "8743437861264538158342807530618454859037982179945996811544197425363443996029025100158882721647"
-    "4500682070419376158454712318346007262933955054823955713725684023226821301247679452264482091023"
-    "5647752723082081063518899152692889108455571126603965034397896278250016110153235160519655904211"
-    "8449499077899920073294769058685778787209829013529566139788848605097860859570177312981553149516"
-    "8146717695976099421003618355913877781769845875810446628399880600616229848616935337386578773598"
-    "3361613384133853684211978938900185295691967804554482858483701170967212535338758621582310133103"
-    "8776682721157269495181795897546939926421979155233857662316762754757035469941489290413018638611"
-    "9439196283887054367774322427680913236544948536676800000106526248547305586159899914017076983854"
-    "8318875014293890899506854530765116803337322265175662207526951791442252808165171667766727930354"
-    "8515420402381746089232839170327542575086765511785939500279338959205766827896776445318404041855"
-    "4010435134838953120132637836928358082719378312654961745997056745071833206503455664403449045362"
-    "7560011250184335607361222765949278393706478426456763388188075656121689605041611390390639601620"
-    "2215368494109260538768871483798955999911209916464644119185682770045742434340216722764455893301"
-    "2778158686952506949936461017568506016714535431581480105458860564550133203758645485840324029871"
-    "7093480910556211671546848477803944756979804263180991756422809873998766973237695737015808068229"
-    "0459921236616890259627304306793165311494017647376938735140933618332161428021497633991898354848"
-    "7562529875242387307755955595546519639440182184099841248982623673771467226061633643296406335728"
-    "1070788758164043814850188411431885988276944901193212968271588841338694346828590066640806314077"
-    "7577257056307294004929403024204984165654797367054855804458657202276378404668233798528271057843"
-    "1975354179501134727362577408021347682604502285157979579764746702284099956160156910890384582450"
-    "2679265942055503958792298185264800706837650418365620945554346135134152570065974881916341359556"
-    "7196496540321872716026485930490397874895890661272507948282769389535217536218507962977851461884"
-    "3271922322381015874445052866523802253284389137527384589238442253547265309817157844783421582232"
-    "7020690287232330053862163479885094695472004795231120150432932266282727632177908840087861480221"
-    "4753765781058197022263097174950721272484794781695729614236585957820908307332335603484653187302"
-    "9302665964501371837542889755797144992465403868179921389346924474198509733462679332107268687076"
-    "8062639919361965044099542167627840914669856925715074315740793805323925239477557441591845821562"
-    "5181921552337096074833292349210345146264374498055961033079941453477845746999921285999993996122"
-    "8161521931488876938802228108300198601654941654261696858678837260958774567618250727599295089318"
-    "0521872924610867639958916145855058397274209809097817293239301067663868240401113040247007350857"
-    "8287246271349463685318154696904669686939254725194139929146524238577625500474852954768147954670"
-    "0705034799958886769501612497228204030399546327883069597624936151010243655535223069061294938859"
-    "9015734661023712235478911292547696176005047974928060721268039226911027772261025441492215765045"
-    "0812067717357120271802429681062037765788371669091094180744878140490755178203856539099104775941"
-    "4132154328440625030180275716965082096427348414695726397884256008453121406593580904127113592004"
-    "1975985136254796160632288736181367373244506079244117639975974619383584574915988097667447093006"
-    "5463424234606342374746660804317012600520559284936959414340814685298150539471789004518357551541"
-    "2522359059068726487863575254191128887737176637486027660634960353679470269232297186832771739323"
-    "6192007774522126247518698334951510198642698878471719396649769070825217423365662725928440620430"
-    "2141137199227852699846988477023238238400556555178890876613601304770984386116870523105531491625"
-    "1728373272867600724817298763756981633541507460883866364069347043720668865127568826614973078865"
-    "7015685016918647488541679154596507234287730699853713904300266530783987763850323818215535597323"
-    "5306860430106757608389086270498418885951380910304235957824951439885901131858358406674723702971"
-    "4978508414585308578133915627076035639076394731145549583226694570249413983163433237897595568085"
-    "6836297253867913275055542524491943589128405045226953812179131914513500993846311774017971512283"
-    "7854601160359554028644059024964669307077690554810288502080858008781157738171917417760173307385"
-    "5475800605601433774329901272867725304318251975791679296996504146070664571258883469797964293162"
-    "2965520168797300035646304579308840327480771811555330909887025505207680463034608658165394876951"
-    "9600440848206596737947316808641564565053004988161649057883115434548505266006982309315777650037"
-    "8070466126470602145750579327096204782561524714591896522360839664562410519551052235723973951288"
-    "1816405978591427914816542632892004281609136937773722299983327082082969955737727375667615527113"
-    "9225880552018988762011416800546873655806334716037342917039079863965229613128017826797172898229"
-    "3607028806908776866059325274637840539769184808204102194471971386925608416245112398062011318454"
-    "1244782050110798760717155683154078865439041210873032402010685341947230476666721749869868547076"
-    "7812051247367924791931508564447753798537997322344561227858432968466475133365736923872014647236"
-    "7942787004250325558992688434959287612400755875694641370562514001179713316620715371543600687647"
-    "7318675587148783989081074295309410605969443158477539700943988394914432353668539209946879645066"
-    "5339857388878661476294434140104988899316005120767810358861166020296119363968213496075011164983"
-    "2785635316145168457695687109002999769841263266502347716728657378579085746646077228341540311441"
-    "5294188047825438761770790430001566986776795760909966936075594965152736349811896413043311662774"
-    "7123388174060373174397054067031096767657486953587896700319258662594105105335843846560233917967"
-    "4926784476370847497833365557900738419147319886271352595462518160434225372996286326749682405806"
-    "0296421146386436864224724887283434170441573482481833301640566959668866769563491416328426414974"
-    "5333499994800026699875888159350735781519588990053951208535103572613736403436753471410483601754"
-    "6488300407846416745216737190483109676711344349481926268111073994825060739495073503169019731852"
-    "1195526356325843390998224986240670310768318446607291248747540316179699411397387765899868554170"
-    "3188477886759290260700432126661791922352093822787888098863359911608192353555704646349113208591"
-    "8979613279131975649097600013996234445535014346426860464495862476909434704829329414041114654092"
-    "3988344435159133201077394411184074107684981066347241048239358274019449356651610884631256785297"
-    "7697346843030614624180358529331597345830384554103370109167677637427621021370135485445092630719"
-    "0114731848574923318167207213727935567952844392548156091372812840633303937356242001604566455741"
-    "4588166052166608738748047243391212955877763906969037078828527753894052460758496231574369171131"
-    "7613478388271941686066257210368513215664780014767523103935786068961112599602818393095487090590"
-    "7386135191459181951029732787557104972901148717189718004696169777001791391961379141716270701895"
-    "8469214343696762927459109940060084983568425201915593703701011049747339493877885989417433031785"
-    "3487076032219829705797511914405109942358830345463534923498268836240433272674155403016195056806"
-    "5418093940998202060999414021689090070821330723089662119775530665918814119157783627292746156185"
-    "7103721724710095214236964830864102592887457999322374955191221951903424452307535133806856807354"
-    "4649951272031744871954039761073080602699062580760202927314552520780799141842906388443734996814"
-    "5827337207266391767020118300464819000241308350884658415214899127610651374153943565721139032857"
-    "4918769094413702090517031487773461652879848235338297260136110984514841823808120540996125274580"
-    "8810994869722161285248974255555160763716750548961730168096138038119143611439921063800508321409"
-    "8760459930932485102516829446726066613815174571255975495358023998314698220361338082849935670557"
-    "5524712902745397762140493182014658008021566536067765508783804304134310591804606800834591136640"
-    "8348874080057412725867047922583191274157390809143831384564241509408491339180968402511639919368"
-    "5322555733896695374902662092326131885589158083245557194845387562878612885900410600607374650140"
-    "2627824027346962528217174941582331749239683530136178653673760642166778137739951006589528877427"
-    "6626368418306801908046098498094697636673356622829151323527888061577682781595886691802389403330"
-    "7644191240341202231636857786035727694154177882643523813190502808701857504704631293335375728538"
-    "6605888904583111450773942935201994321971171642235005644042979892081594307167019857469273848653"
-    "8334361457946341759225738985880016980147574205429958012429581054565108310462972829375841611625"
-    "3256251657249807849209989799062003593650993472158296517413579849104711166079158743698654122234"
-    "8341887722929446335178653856731962559852026072947674072616767145573649812105677716893484917660"
-    "7717052771876011999081441130586455779105256843048114402619384023224709392498029335507318458903"
-    "5539713308844617410795916251171486487446861124760542867343670904667846867027409188101424971114"
-    "9657817724279347070216688295610877794405048437528443375108828264771978540006509704033021862556"
-    "1473321177711744133502816088403517814525419643203095760186946490886815452856213469883554445602"
-    "4955666843660292219512483091060537720198021831010327041783866544718126039719068846237085751808"
-    "0035327047185659499476124248110999288679158969049563947624608424065930948621507690314987020673"
-    "5338483495508363660178487710608098042692471324100094640143736032656451845667924566695510015022"
-    "9833079849607994988249706172367449361226222961790814311414660941234159359309585407913908720832"
-    "2733549572080757165171876599449856937956238755516175754380917805280294642004472153962807463602"
-    "1132942559160025707356281263873310600589106524570802447493754318414940148211999627645310680066"
-    "3118382376163966318093144467129861552759820145141027560068929750246304017351489194576360789352"
-    "8555053173314164570504996443890936308438744847839616840518452732884032345202470568516465716477"
-    "1393237755172947951261323982296023945485797545865174587877133181387529598094121742273003522965"
-    "0808917770506825924882232215493804837145478164721397682096332050830564792048208592047549985732"
-    "0388876391601995240918938945576768749730856955958010659526503036266159750662225084067428898265"
-    "9075106375635699682115109496697445805472886936310203678232501823237084597901115484720876182124"
-    "7781326633041207621658731297081123075815982124863980721240786887811450165582513617890307086087"
-    "0198975889807456643955157415363193191981070575336633738038272152798849350397480015890519420879"
-    "7113080512339332219034662499171691509485414018710603546037946433790058909577211808044657439628"
-    "0618671786101715674096766208029576657705129120990794430463289294730615951043090222143937184956"
-    "0634056189342513057268291465783293340524635028929175470872564842600349629611654138230077313327"
-    "2983050016025672401418515204189070115428857992081219844931569990591820118197335001261877280368"
-    "1248199587707020753240636125931343859554254778196114293516356122349666152261473539967405158499"
-    "8603552953329245752388810136202347624669055816438967863097627365504724348643071218494373485300"
-    "6063876445662721866617012381277156213797461498613287441177145524447089971445228856629424402301"
-    "8479120547849857452163469644897389206240194351831008828348024924908540307786387516591130287395"
-    "8787098100772718271874529013972836614842142871705531796543076504534324600536361472618180969976"
-    "9334862640774351999286863238350887566835950972655748154319401955768504372480010204137498318722"
-    "5967738715495839971844490727914196584593008394263702087563539821696205532480321226749891140267"
-    "8528599673405242031091797899905718821949391320753431707980023736590985375520238911643467185582"
-    "9068537118979526262344924833924963424497146568465912489185566295893299090352392333336474352037"
-    "0770101084388003290759834217018554228386161721041760301164591878053936744747205998502358289183"
-    "3692922337323999480437108419659473162654825748099482509991833006976569367159689364493348864744"
-    "2135008407006608835972350395323401795825570360169369909886711321097988970705172807558551912699"
-    "3067309925070407024556850778679069476612629808225163313639952117098452809263037592242674257559"
-    "9892892783704744452189363203489415521044597261883800300677617931381399162058062701651024458869"
-    "2476492468919246121253102757313908404700071435613623169923716948481325542009145304103713545329"
-    "6620639210547982439212517254013231490274058589206321758949434548906846399313757091034633271415"
-    "3162232805522972979538018801628590735729554162788676498274186164218789885741071649069191851162"
-    "8152854867941736389066538857642291583425006736124538491606741373401735727799563410433268835695"
-    "0781493137800736235418007061918026732855119194267609122103598746924117283749312616339500123959"
-    "9240508454375698507957046222664619000103500490183034153545842833764378111988556318777792537201"
-    "1667185395418359844383052037628194407615941068207169703022851522505731260930468984234331527321"
-    "3136121658280807521263154773060442377475350595228717440266638914881717308643611138906942027908"
-    "8143119448799417154042103412190847094080254023932942945493878640230512927119097513536000921971"
-    "1054120966831115163287054230284700731206580326264171161659576132723515666625366727189985341998"
-    "9523688483099930275741991646384142707798870887422927705389122717248632202889842512528721782603"
-    "0500994510824783572905691988555467886079462805371227042466543192145281760741482403827835829719"
-    "3010178883456741678113989547504483393146896307633966572267270433932167454218245570625247972199"
-    "7866854279897799233957905758189062252547358220523642485078340711014498047872669199018643882293"
-    "2305382318559732869780922253529591017341407334884761005564018242392192695062083183814546983923"
-    "6646136398910121021770959767049083050818547041946643713122996923588953849301363565761861060622"
-    "2870559942337163102127845744646398973818856674626087948201864748767272722206267646533809980196"
-    "6883680994159075776852639865146253336312450536402610569605513183813174261184420189088853196356"
-    "9869627950367384243130113317533053298020166888174813429886815855778103432317530647849832106297"
-    "1842518438553442762012823457071698853051832617964117857960888815032960229070561447622091509473"
-    "9035946646916235396809201394578175891088931992112260073928149169481615273842736264298098234063"
-    "2002440244958944561291670495082358124873917996486411334803247577752197089327722623494860150466"
-    "5268143987705161531702669692970492831628550421289814670619533197026950721437823047687528028735"
-    "4126166391708245925170010714180854800636923259462019002278087409859771921805158532147392653251"
-    "5590354102092846659252999143537918253145452905984158176370589279069098969111643811878094353715"
-    "2133226144362531449012745477269573939348154691631162492887357471882407150399500944673195431619"
-    "3855485207665738825139639163576723151005556037263394867208207808653734942440115799667507360711"
-    "1593513319591971209489647175530245313647709420946356969822266737752099451684506436238242118535"
-    "3488798939567318780660610788544000550827657030558744854180577889171920788142335113866292966717"
-    "9643468760077047999537883387870348718021842437342112273940255717690819603092018240188427057046"
-    "0926225641783752652633583242406612533115294234579655695025068100183109004112453790153329661569"
-    "7052237921032570693705109083078947999900499939532215362274847660361367769797856738658467093667"
-    "9588583788795625946464891376652199588286933801836011932368578558558195556042156250883650203322"
-    "0245137621582046181067051953306530606065010548871672453779428313388716313955969058320834168984"
-    "7606560711834713621812324622725884199028614208728495687963932546428534307530110528571382964370"
-    "9990356948885285190402956047346131138263878897551788560424998748316382804046848618938189590542"
-    "0398898726506976202019955484126500053944282039301274816381585303964399254702016727593285743666"
-    "6164411096256633730540921951967514832873480895747777527834422109107311135182804603634719818565"
-    "5572957144747682552857863349342858423118749440003229690697758315903858039353521358860079600342"
-    "0975473922967333106493956018122378128545843176055617338611267347807458506760630482294096530411"
-    "1830667108189303110887172816751957967534718853722930961614320400638132246584111115775835858113"
-    "5018569047815368938137718472814751998350504781297718599084707621974605887423256995828892535041"
-    "9379582606162118423687685114183160683158679946016520577405294230536017803133572632670547903384"
-    "0125730591233960188013782542192709476733719198728738524805742124892118347087662966720727232565"
-    "0565129333126059505777727542471241648312832982072361750574673870128209575544305968395555686861"
-    "1883971355220844528526400812520276655576774959696266126045652456840861392382657685833846984997"
-    "7872670655519185446869846947849573462260629421962455708537127277652309895545019303773216664918"
-    "2578154677292005212667143463209637891852323215018976126034373684067194193037746880999296877582"
-    "4410478781232662531818459604538535438391144967753128642609252115376732588667226040425234910870"
-    "2695809964759580579466397341906401003636190404203311357933654242630356145700901124480089002080"
-    "1478056603710154122328891465722393145076071670643556827437743965789067972687438473076346451677"
-    "5621030986040927170909512808630902973850445271828927496892121066700816485833955377359191369501"
-    "5316201890888748421079870689911480466927065094076204650277252865072890532854856143316081269300"
-    "5693785417861096969202538865034577183176686885923681488475276498468821949739729707737187188400"
-    "4143231276365048145311228509900207424092558592529261030210673681543470152523487863516439762358"
-    "6041919412969769040526483234700991115424260127343802208933109668636789869497799400126016422760"
-    "9260823493041180643829138347354679725399262338791582998486459271734059225620749105308531537182"
-    "9116816372193951887009577881815868504645076993439409874335144316263303172477474868979182092394"
-    "8083314397084067308407958935810896656477585990556376952523265361442478023082681183103773588708"
-    "9240613031336477371011628214614661679404090518615260360092521947218890918107335871964142144478"
-    "6548995285823439470500798303885388608310357193060027711945580219119428999227223534587075662469"
-    "2617766317885514435021828702668561066500353105021631820601760921798468493686316129372795187307"
-    "8972637353717150256378733579771808184878458866504335824377004147710414934927438457587107159731"
-    "5594394264125702709651251081155482479394035976811881172824721582501094960966253933953809221955"
-    "9191818855267806214992317276316321833989693807561685591175299845013206712939240414459386239880"
-    "9381240452191484831646210147389182510109096773869066404158973610476436500068077105656718486281"
-    "4963711188321924456639458144914861655004956769826903089111856879869294705135248160917432430153"
-    "8368470729289898284602223730145265567989862776796809146979837826876431159883210904371561129976"
-    "6521539635464420869197567370005738764978437686287681792497469438427465256316323005551304174227"
-    "3416464551278127845777724575203865437542828256714128858345444351325620544642410110379554641905"
-    "8116862305964476958705407214198521210673433241075676757581845699069304604752277016700568454396"
-    "9234041711089888993416350585157887353430815520811772071880379104046983069578685473937656433631"
-    "9797868036718730796939242363214484503547763156702553900654231179201534649779290662415083288583"
-    "9529054263768766896880503331722780018588506973623240389470047189761934734430843744375992503417"
-    "8807972235859134245813144049847701732361694719765715353197754997162785663119046912609182591249"
-    "8903676541769799036237552865263757337635269693443544004730671988689019681474287677908669796885"
-    "2250163694985673021752313252926537589641517147955953878427849986645630287883196209983049451987"
-    "4396369070682762657485810439112232618794059941554063270131989895703761105323606298674803779153"
-    "7675115830432084987209202809297526498125691634250005229088726469252846661046653921714820801305"
-    "0229805263783642695973370705392278915351056888393811324975707133102950443034671598944878684711"
-    "6438328050692507766274500122003526203709466023414648998390252588830148678162196775194583167718"
-    "7627572005054397944124599007711520515461993050983869825428464072555409274031325716326407929341"
-    "8334214709041254253352324802193227707535554679587163835875018159338717423606155117101312352563"
-    "3485820365146141870049205704372018261733194715700867578539336078622739558185797587258744102542"
-    "0771054753612940474601000940954449596628814869159038990718659805636171376922272907641977551777"
-    "2010427649694961105622059250242021770426962215495872645398922769766031052498085575947163107587"
-    "0133208861463266412591148633881220284440694169488261529577625325019870359870674380469821942056"
-    "3812558334364219492322759372212890564209430823525440841108645453694049692714940033197828613181"
-    "8618881111840825786592875742638445005994422956858646048103301538891149948693543603022181094346"
-    "6764000022362550573631294626296096198760564259963946138692330837196265954739234624134597795748"
-    "5246478379807956931986508159776753505539189911513352522987361127791827485420086895396583594219"
-    "6333150286956119201229888988700607999279541118826902307891310760361763477948943203210277335941"
-    "6908650071932804017163840644987871753756781185321328408216571107549528294974936214608215583205"
-    "6872321855740651610962748743750980922302116099826330339154694946444910045152809250897450748967"
-    "6032409076898365294065792019831526541065813682379198409064571246894847020935776119313998024681"
-    "3405200394781949866202624008902150166163813538381515037735022966074627952910384068685569070157"
-    "5166241929872444827194293310048548244545807188976330032325258215812803274679620028147624318286"
-    "2217105435289834820827345168018613171959332471107466222850871066611770346535283957762599774467"
-    "2185715816126411143271794347885990892808486694914139097716736900277758502686646540565950394867"
-    "8411107901161040085727445629384254941675946054871172359464291058509099502149587931121961359083"
-    "1588262068233215615308683373083817327932819698387508708348388046388478441884003184712697454370"
-    "9373298362402875197920802321878744882872843727378017827008058782410749357514889978911739746129"
-    "3203510814327032514090304874622629423443275712600866425083331876886507564292716055252895449215"
-    "3765175149219636718104943531785838345386525565664065725136357506435323650893679043170259787817"
-    "7190314867963840828810209461490079715137717099061954969640070867667102330048672631475510537231"
-    "7571143223174114116806228642063889062101923552235467116621374996932693217370431059872250394565"
-    "7492461697826097025335947502091383667377289443869640002811034402608471289900074680776484408871"
-    "1341352503367877316797709372778682166117865344231732264637847697875144332095340001650692130546"
-    "4768909850502030150448808342618452087305309731894929164253229336124315143065782640702838984098"
-    "4160295030924189712097160164926561341343342229882790992178604267981245728534580133826099587717"
-    "8113102167340256562744007296834066198480676615805021691833723680399027931606420436812079900316"
-    "2644491461902194582296909921227885539487835383056468648816555622943156731282743908264506116289"
-    "4280350166133669782405177015521962652272545585073864058529983037918035043287670380925216790757"
-    "1204061237596327685674845079151147313440001832570344920909712435809447900462494313455028900680"
-    "6487042935340374360326258205357901183956490893543451013429696175452495739606214902887289327925"
-    "2069653538639644322538832752249960598697475988232991626354597332444516375533437749292899058117"
-    "5786355555626937426910947117002165411718219750519831787137106051063795558588905568852887989084"
-    "7509157646390746936198815078146852621332524738376511929901561091897779220087057933964638274906"
-    "8069876916819749236562422608715417610043060890437797667851966189140414492527048088197149880154"
-    "2057787006521594009289777601330756847966992955433656139847738060394368895887646054983871478968"
-    "4828053847017308711177611596635050399793438693391197898871091565417091330826076474063057114110"
-    "9883938809548143782847452883836807941888434266622207043872288741394780101772139228191199236540"
-    "5516395893474263953824829609036900288359327745855060801317988407162446563997948275783650195514"
-    "2215513392819782269842786383916797150912624105487257009240700454884856929504481107380879965474"
-    "8156891393538094347455697212891982717702076661360248958146811913361412125878389557735719498631"
-    "7210844398901423948496659251731388171602663261931065366535041473070804414939169363262373767777"
-    "0958503132559900957627319573086480424677012123270205337426670531424482081681303063973787366424"
-    "8367253983748769098060218278578621651273856351329014890350988327061725893257536399397905572917"
-    "5160097615459044771692265806315111028038436017374742152476085152099016158582312571590733421736"
-    "5762671423904782795872815050956330928026684589376496497702329736413190609827406335310897924642"
-    "4213458374090116939196425045912881340349881063540088759682005440836438651661788055760895689672"
-    "7531538081942077332597917278437625661184319891025007491829086475149794003160703845549465385946"
-    "0274524474668123146879434416109933389089926384118474252570445725174593257389895651857165759614"
-    "8126602031079762825416559050604247911401695790033835657486925280074302562341949828646791447632"
-    "2774005529460903940177536335655471931000175430047504719144899841040015867946179241610016454716"
-    "5513370740739502604427695385538343975505488710997852054011751697475813449260794336895437832211"
-    "7245068734423198987884412854206474280973562580706698310697993526069339213568588139121480735472"
-    "8463227784908087002467776303605551232386656295178853719673034634701222939581606792509153217489"
-    "0308408865160611190114984434123501246469280288059961342835118847154497712784733617662850621697"
-    "7871774382436256571177945006447771837022199910669502165675764404499794076503799995484500271066"
-    "5987813603802314126836905783190460792765297277694043613023051787080546511542469395265127101052"
-    "9270703066730244471259739399505146284047674313637399782591845411764133279064606365841529270190"
-    "3027601733947486696034869497654175242930604072700505903950314852292139257559484507886797792525"
-    "3931765156416197168443524369794447355964260633391055126826061595726217036698506473281266724521"
-    "9890605498802807828814297963366967441248059821921463395657457221022986775997467381260693670691"
-    "3408155941201611596019023775352555630060624798326124988128819293734347686268921923977783391073"
-    "3106588256813777172328315329082525092733047850724977139448333892552081175608452966590553940965"
-    "5685417060011798572938139982583192936791003918440992865756059935989100029698644609747147184701"
-    "0153128376263114677420914557404181590880006494323785583930853082830547607679952435739163122188"
-    "6057549673832243195650655460852881201902363644712703748634421727257879503428486312944916318475"
-    "3475314350413920961087960577309872013524840750576371992536504709085825139368634638633680428917"
-    "6710760211115982887553994012007601394703366179371539630613986365549221374159790511908358829009"
-    "7656647300733879314678913181465109316761575821351424860442292445304113160652700974330088499034"
-    "6754055186406773426035834096086055337473627609356588531097609942383473822220872924644976845605"
-    "7956251676557408841032173134562773585605235823638953203853402484227337163912397321599544082842"
-    "1666636023296545694703577184873442034227706653837387506169212768015766181095420097708363604361"
-    "1105924091178895403380214265239489296864398089261146354145715351943428507213534530183158756282"
-    "7573389826889852355779929572764522939156747756667605108788764845349363606827805056462281359888"
-    "5879259940946446041705204470046315137975431737187756039815962647501410906658866162180038266989"
-    "9619655805872086397211769952194667898570117983324406018115756580742841829106151939176300591943"
-    "1443460515404771057005433900018245311773371895585760360718286050635647997900413976180895536366"
-    "9603162193113250223851791672055180659263518036251214575926238369348222665895576994660491938112"
-    "4866090997981285718234940066155521961122072030922776462009993152442735894887105766238946938894"
-    "4649509396033045434084210246240104872332875008174917987554387938738143989423801176270083719605"
-    "3094383940063756116458560943129517597713935396074322792489221267045808183313764165818269562105"
-    "8728924477400359470092686626596514220506300785920024882918608397437323538490839643261470005324"
-    "2354064704208949921025040472678105908364400746638002087012666420945718170294675227854007450855"
-    "2377720890581683918446592829417018288233014971554235235911774818628592967605048203864343108779"
-    "5628929254056389466219482687110428281638939757117577869154301650586029652174595819888786804081"
-    "1032843273986719862130620555985526603640504628215230615459447448990883908199973874745296981077"
-    "6201487134000122535522246695409315213115337915798026979555710508507473874750758068765376445782"
-    "5244326380461430428892359348529610582693821034980004052484070844035611678171705128133788057056"
-    "4345061611933042444079826037795119854869455915205196009304127100727784930155503889536033826192"
-    "9343797081874320949914159593396368110627557295278004254863060054523839151068998913578820019411"
-    "7865356821491185282078521301255185184937115034221595422445119002073935396274002081104655302079"
-    "3286725474054365271759589350071633607632161472581540764205302004534018357233829266191530835409"
-    "5120226329165054426123619197051613839357326693760156914429944943744856809775696303129588719161"
-    "1292946818849363386473927476012269641588489009657170861605981472044674286642087653347998582220"
-    "9061980217321161423041947775499073873856794118982466091309169177227420723336763503267834058630"
-    "1930193242996397204445179288122854478211953530898910125342975524727635730226281382091807439748"
-    "6714535907786335301608215599113141442050914472935350222308171936635093468658586563148555758624"
-    "4781862010871188976065296989926932817870557643514338206014107732926106343152533718224338526352"
-    "0217735440715281898137698755157574546939727150488469793619500477720970561793913828989845327426"
-    "2272886471088832701737232588182446584362495805925603381052156062061557132991560848920643403033"
-    "9526226345145428367869828807425142256745180618414956468611163540497189768215422772247947403357"
-    "1527436819409892050113653400123846714296551867344153741615042563256713430247655125219218035780"
-    "1692403266995417460875924092070046693403965101781348578356944407604702325407555577647284507518"
-    "2689041829396611331016013111907739863246277821902365066037404160672496249013743321724645409741"
-    "2995570529142438208076098364823465973886691349919784013108015581343979194852830436739012482082"
-    "4448141280954437738983200598649091595053228579145768849625786658859991798675205545580990045564"
-    "6117875524937012455321717019428288461740273664997847550829422802023290122163010230977215156944"
-    "6427909802190826689868834263071609207914085197695235553488657743425277531197247430873043619511"
-    "3961190800302558783876442060850447306312992778889427291897271698905759252446796601897074829609"
-    "4919064876469370275077386643239191904225429023531892337729316673608699622803255718530891928440"
-    "3805071030064776847863243191000223929785255372375566213644740096760539439838235764606992465260"
-    "0890906241059042154539279044115295803453345002562441010063595300395988644661695956263518780606"
-    "8851372346270799732723313469397145628554261546765063246567662027924520858134771760852169134094"
-    "6520307673391841147504140168924121319826881568664561485380287539331160232292555618941042995335"
-    "6400957864953409351152664540244187759493169305604486864208627572011723195264050230997745676478"
-    "3848897346431721598062678767183800524769688408498918508614900343240347674268624595239589035858"
-    "2135006450998178244636087317754378859677672919526111213859194725451400301180503437875277664402"
-    "7626189410175768726804281766238606804778852428874302591452470739505465251353394595987896197789"
-    "1104189029294381856720507096460626354173294464957661265195349570186001541262396228641389779673"
-    "3329070567376962156498184506842263690367849555970026079867996261019039331263768556968767029295"
-    "3711625280055431007864087289392257145124811357786276649024251619902774710903359333093049483805"
-    "9785662884478744146984149906712376478958226329490467981208998485716357108783119184863025450162"
-    "0929805829208334813638405421720056121989353669371336733392464416125223196943471206417375491216"
-    "3570085736943973059797097197266666422674311177621764030686813103518991122713397240368870009968"
-    "6292254646500638528862039380050477827691283560337254825579391298525150682996910775425764748832"
-    "5341412132800626717094009098223529657957997803018282428490221470748111124018607613415150387569"
-    "8309186527806588966823625239378452726345304204188025084423631903833183845505223679923577529291"
-    "0692504326144695010986108889991465855188187358252816430252093928525807796973762084563748211443"
-    "3988162710031703151334402309526351929588680690821355853680161000213740851154484912685841268695"
-    "8991741491338205784928006982551957402018181056412972508360703568510553317878408290000415525118"
-    "6577945396331753853209214972052660783126028196116485809868458752512999740409279768317663991465"
-    "5386108937587952214971731728131517932904431121815871023518740757222100123768721944747209349312"
-    "3241070650806185623725267325407333248757544829675734500193219021991199607979893733836732425761"
-    "0393898534927877747398050808001554476406105352220232540944356771879456543040673589649101761077"
-    "5948364540823486130254718476485189575836674399791508512858020607820554462991723202028222914886"
-    "9593997299742974711553718589242384938558585954074381048826246487880533042714630119415898963287"
-    "9267832732245610385219701113046658710050008328517731177648973523092666123458887310288351562644"
-    "6023671996644554727608310118788389151149340939344750073025855814756190881398752357812331342279"
-    "8665035227253671712307568610450045489703600795698276263923441071465848957802414081584052295369"
-    "3749971066559489445924628661996355635065262340533943914211127181069105229002465742360413009369"
-    "1889255865784668461215679554256605416005071276641766056874274200329577160643448606201239821698"
-    "2717231978268166282499387149954491373020518436690767235774000539326626227603236597517189259018"
-    "0110429038427418550789488743883270306328327996300720069801224436511639408692222074532024462412"
-    "1155804354542064215121585056896157356414313068883443185280853975927734433655384188340303517822"
-    "9462537020157821573732655231857635540989540332363823192198921711774494694036782961859208034038"
-    "6757583411151882417743914507736638407188048935825686854201164503135763335550944031923672034865"
-    "1010561049872726472131986543435450409131859513145181276437310438972507004981987052176272494065"
-    "2146199592321423144397765467083517147493679861865527917158240806510637995001842959387991583501"
-    "7158075988378496225739851212981032637937621832245659423668537679911314010804313973233544909082"
-    "4910499143325843298821033984698141715756010829706583065211347076803680695322971990599904451209"
-    "0872757762253510409023928887794246304832803191327104954785991801969678353214644411892606315266"
-    "1816744319355081708187547705080265402529410921826485821385752668815558411319856002213515888721"
-    "0365696087515063187533002942118682221893775546027227291290504292259787710667873840000616772154"
-    "6384412923711935218284998243509208918016855727981564218581911974909857305703326676464607287574"
-    "3056537260276898237325974508447964954564803077159815395582777913937360171742299602735310276871"
-    "9449444917939785144631597314435351850491413941557329382048542123508173912549749819308714396615"
-    "1329420459193801062314217741991840601803479498876910515579055548069538785400664533759818628464"
-    "1990522045280330626369562649091082762711590385699505124652999606285544383833032763859980079292"
-    "2846659503551211245284087516229060262011857775313747949362055496401073001348853150735487353905"
-    "6029089335264007132747326219603117734339436733857591245081493357369116645412817881714540230547"
-    "5066713651825828489809951213919399563324133655677709800308191027204099714868741813466700609405"
-    "1021462690280449159646545330107754695413088714165312544813061192407821188690056027781824235022"
-    "6961893443525476335735364856193632544177566139817039306328721669057222597452091929172621998444"
-    "0964615826945638023950283712168644656178523556516412771282691868861557271620147493405227694659"
-    "5712198314943381622114006936307430444173284786101777743837977037231795255434107223445512555589"
-    "9986461838767649039724611679590181000350989286412041951635511087632042676129798265294258829511"
-    "4127584126273279079880755975185157684126474220947972184330935297266521001566251455299474512763"
-    "1550917636730259462132930190402837954246323258550301096706922720227074863419005438302650681214"
-    "1421350571541750575086399076739463351462090828889349383764393992569006040673114220933121959362"
-    "0298297235116325938677224147791162957278075239505625158160313335938231150051862689053065836812"
-    "9988108663263271980611271548858798093487912913707498230575929091862939195014721197586067270092"
-    "5477180257503377307993971345395326461952699965963856549175904583335857991020127132045839032008"
-    "5387888163363768518208372788513117522776960978796214237216254521459128183179821604411131167140"
-    "6914827170981015457781939202311563871950805024679725792497605772625913328559726371211201905720"
-    "7714091486450740949267180358151575715140503976109638467555692989703835473141002238025834687673"
-    "5012977541327953206097115450648421218593649099791776687477448188287063231551586503289816422828"
-    "8232746866106592732197907162384642153489852476216789050260998045266483929542357287343977680495"
-    "7740914495383915755654854590589764951985138010079580107837599457752991967005476022525520344539"
-    "8871253878017196071816407812484784725791240782454436168234523957068951427226975043187363326301"
-    "1103053423335821609333191218806608268341428910415173247216053355849993224548730778822905252324"
-    "2348615315209769384610425828497149634753418375620030149157032796853018686315724884015266398356"
-    "8956363465743532178349319982554211730846774529708583950761645822963032442432823773745051702856"
-    "0698067889521768198156710781633405266759539424926280756968326107495323390536223090807081455919"
-    "8373553777487420290390181429373115293346444681512129450975965343062842153194457271186149000176"
-    "5055817709530246887526325011970520947615941676872778447200019278913725184162285778379228443908"
-    "4301181121496366424659033634194540657183544771912446621259392656620306888520055599121235363718"
-    "2269225317814587925937504414489339816086579008761650246351970458288954817937566810464746141051"
-    "4249887025213993687050937230544773411264135489280684105910771667782123833281026218558775131272"
-    "1179344448201440425745083063944738363793906283008973306241380614589414227694747931665717623182"
-    "4721683506780764875734204915576282175839729751344789906965895325489403356156131674032764724692"
-    "1250575911625152965456854463349811431767025729566184477548746937846423373723898192066204851189"
-    "4378868224807279352022501796545343757274163910791972952950812942922205347717304184477915673991"
-    "7384183117103625243957161527146690058147000026330104526435478659032907332054683388720787354447"
-    "6264792529769017091200787418373673508771337697768349634425241994995138831507487753743384945825"
-    "9765560996555954318040920178497184685497370696212088524377013853757681416632722412634423982152"
-    "9416453780004925072627651507890850712659970367087266927643083772296859851691223050374627443108"
-    "5293430527307886528397733524601746352770320593817912539691562106363762588293757137384075440646"
-    "8964783100704580613446731271591194608435935825987782835266531151065041623295329047772174083559"
-    "3497237585521380483050900096466760883015406128243087406455944318534137552201663058121110334531"
-    "2074508682433943215904359443031243122747138584203039010607094031523555617276799416002039397509"
-    "9897629335325855575624808996691829864222677502360193257974726742578211119734709402357457222271"
-    "2125268523842958742735015636600931880454933389897415714905441825597380808715652814301026704602"
-    "8431681923039253529779576586241439270154974087927313105163611913757700892956482332364829826302"
-    "4607975875767745377160102490804624301856524161756655600160859121534556267602192689982855377872"
-    "5831451440826545834844094784631787773747946535801699607794055687011923286080411309046293508718"
-    "2712593466871276669487389982459852778649956916546402945893506496433580982476596516514209098675"
-    "5203808309203230487342703468288751604071546653834619611223013759451579252696743642531927390036"
-    "0386082364507626988274976187235754767628899507521148048525279508450339585708381304769378813211"
-    "2367428131948795022806632017002246033198967197064916374117585485187848401205484467258885140156"
-    "2725019821719066960812627785485964818369621410721714214986361918774754509650308957099470934337"
-    "8569816744658282679119406119560378453978558392407612763441057667510243075598145527861678159496"
-    "5706255975507430652108530159790807334373607943286675789053348366955548680391343372015649883422"
-    "0893399971641479746938696905480089193067138057171505857307148815649920714086758259602876056459"
-    "7824237702424698053280566327870419267684671162668794634869504645074202193739452592626686135529"
-    "4062478136120620263649819999949840514386828525895634226432870766329930489172340072547176418868"
-    "5351372332667877921738347541480022803392997357936152412755829569276837231234798989446274330454"
-    "5667900620324205163962825884430854383072014956721064605332385372031432421126074244858450945804"
-    "9408182092763914000854042202355626021856434899414543995041098059181794888262805206644108631900"
-    "1688568155169229486203010738897181007709290590480749092427141018933542818429995988169660993836"
-    "9616443815288772140852680887574882932587358099056707558170179491619061140019085537448827262009"
-    "3668560447559655747648567400817738170330738030547697360978654385938218722058390234444350886749"
-    "9866506040645874346005331827436296177862518081893144363251205107094690813586440519229512932450"
-    "0788333987884293393424351263433652043858129128343452973086529097833006712617981303167943855357"
-    "2629699874035957045845223085639009891317947594875212639707837594486113945196028675121056163897"
-    "6008880092746115860800207803341591451797073036835196977766076373785333012024120112046988609209"
-    "3390853657732223924124490515327809509558664594776344822699860748132973026309750288121035177231"
-    "2446509534965369309001863776409409434983731325132186208021480992268550294845466181471555744470"
-    "9669530177690434272031892770604717784527939160472281534379803539679861424370956683221491465438"
-    "0145938292773933960327540480095522318166673803571839327570771420467238386246178039762923771312"
-    "0958078936384144792980258806552212926209362393063731349664018661951081158347117331202580586672"
-    "7639992763579078063818813069156366274125431259589936119647626101405563503399523140323113819656"
-    "2363271989618372548453337020625634642239527669435683767613687119629218187545760816170530315907"
-    "2882870071231366630872275491866139577373054606599743781098764980241401124214277366808275139095"
-    "9313404155826266789510846776118665957660165998178089414985754976284387856100263796543178313634"
-    "0251358141611519020964991335487331311150227006819301359295959716401971960536250335584799809634"
-    "8871803911161281359596856547886832585643789617315976200241962155289629790481982219946226948713"
-    "7462444729093456470028537694958859591606789282491054412515996300781368367490209374915732896270"
-    "0286568293444313423473512392982591667395034259958689706972673325827359031212887466604514614878"
-    "5034614282776599160809039865257571726308183349444182019353338507129234577437557934406217871133"
-    "0063106003324053991693682603746176638565758877580201229366353270267100681261825172914608202541"
-    "8928859352444910701382062115538277935652969145765020486432828655579347072096348073726921411868"
-    "9546732276775133569019015372366903686538916129168888787640752549349424973342718117889275993159"
-    "6719354758988097924525262363659036320070854440784544797348291802082044926670634420437555325050"
-    "5275228337788870408040335319234076856301093477721256390886404131010738178533383160381352808281"
-    "1904083256440184205374679299262203769871801806112262449090924264198582086175117711378905160914"
-    "0381575003366424156095216328197122335023167422600567941281406217219641842705784328959802882335"
-    "0598282081966662490358577899403331522748177769528436816300885317696947836905806710648280835980"
-    "4669884109813515865490693331952239436328792399053481098783027450017206543369906611778455436468"
-    "7723631844464768069142828004551074686645392805399409108754939166095731619715033166968309929466"
-    "3491427987808422572206971488755806374803088629951184731871247772919100702275888934869394562895"
-    "1580296537215040960310776128983126358996489341024703603664505868728758905140684123812424738638"
-    "5427908282733827973326885504935874303160274749063129572349742611221517417153133618622410913869"
-    "5006888358989623492763173164783400774608866555987333821138299287769114954921841920877716060684"
-    "7287467368188616750722101726110383067178785669481294878504894306308616994879870316051588410828"
-    "2351274153538513365895332948629494495061868514779105804696039069372662670386512905201137810858"
-    "6161888869479576074135855345851517680519733344334952301203957707396237713160302428872005373209"
-    "9825300897761897312981788194467173116064723147624845755192873278282512718244680782421521646956"
-    "7819294098238926284943760248852279003620219386696482215628093605373178040863727268426696421929"
-    "9468192149087017075333610947913818040632873875938482695355830773957614479972700034728801827852"
-    "8138950321798634521611106660883931405322694490545552786789441757920244002145078019209980446138"
-    "2547805858048442416404775031536054906591430078158372430123137511562284015838644270890718284816"
-    "7575271238467824595343344496220100960710513706084618011875431207254913349942476171156333214089"
-    "3460915656155060031738421870157022610310191660388706466143889773631878094071152752817468957640"
-    "1581047016965247557740891644568677717158500583269943401677202156767724068128366565264122982439"
-    "4651331973591997094032759385026695574702318132032437164205861410336065245369391600506449530601"
-    "6126782264894243739716671766123104897503188573216555498834212180284691252908610148552781527762"
-    "5623750456375769497734336846015607727035509629049392487088406281067943622418704747008368842671"
-    "0225583024035998416459511224852726336326451140173952480861946358407837535568856223171155209472"
-    "2306543709260679735100056554938122457548372854571179739361575616764169289580525729752233855861"
-    "1388322171107362265816218842443178857488798109026653793426664216990914056536432249301334867988"
-    "1548866286650523469972355747384248305904236771432787923164224038777643301926001922847783138376"
-    "3253612102533693581262408686669973827597736568222790721583247888864236934639616436330873013981"
-    "4211430306008730666164803678984091335926293402304324974926887831643602681011309570716141912830"
-    "6865773235326396536773903176613613159655535849993986005651559219367599777179330197446881483711"
-    "0320650369319289452140265091546518430993655349333718342529843367991593941746622390038952767381"
-    "3330617747629574943868716978453767219493506590875711917720875477107189937960894774512654757501"
-    "8711948707387367858902006173733210756933022163206284320656711920969505857611739616323262177089"
-    "4542621460985841023781321581772760222273813349541048100307327510779994899197796388353073444345"
-    "7532975914263768405442264784216063122769646967156473999043715903323906560726644116438605404838"
-    "8471619121090087010191307260710441141432419767968285478855247794764818029597360494397004795960"
-    "4029274629920357209976195014034831538094771460105633344699882082212058728151072918297121191787"
-    "6424880354672316916541852256729234429187128163232596965413548589577133208339911288775917226115"
-    "2733790103413620856145779923987783250835507301998184590259583559892605532996737704917224549353"
-    "2968330000223018151722657578752405883224908582128008974790932610076257877042865600699617621217"
-    "6845478996440705066241710213327486796237430229155358200780141165348065647488230615003392068983"
-    "7947662550365498228053296628621179306284301704924023019857199789488368971830438051821744191476"
-    "6042975243725168343541121703863137941142209529588579806015293875275379903093887168357209576071"
-    "5221900279379292786303637268765822681241993384808166021603722154710143007377537792699069587121"
-    "2892880190520316012858618254944133538207848834653116326504076424283908701210151942319616522684"
-    "2200371123046430067344206474771802135307012409886035339915266792387110170622186588357378121093"
-    "5179775604425634694999787251125440854522274810914874307259869602040275941178942581281882159952"
-    "3596589791811440776533543217575952555361581280011638467203193465072968079907939637149617743121"
-    "1940202129757312516525376801735910155733815377200195244454362007184847566341540744232862106099"
-    "7613243487548847434539665981338717466093020535070271952983943271425371155766600025784423031073"
-    "4295515339450604862227649666876240793243531929926392537310768921353525723210808898193391686682"
-    "7894828117047262450194840970097576092098372409007471797334078814182519584259809624174761013825"
-    "2643955135259311885045636264188300338539652435997416931322894719878308427600401368074703904097"
-    "2384739458348961865397905941185993103561684368692194853820557803957738813606795499000851232594"
-    "4252972448666676683464140218991594456530942344065066785194841776677947047204195882204329538032"
-    "6310537494883122180391279678446100139726753892195119117836587662528083690053249004597410947068"
-    "7729123282143046353372835199536482743258331191444590178096077828835837301118575436599589827245"
-    "3192531058811502630754257149394302445393187017992360816661130542625399583389794297160207033876"
-    "7815033010280120095997252222280801423571094760351925544434929986767817891045559063015953809761"
-    "8759203589373419789623589311259839025983102671933041892151096891562250696591198283234555030590"
-    "8173073519550372166587028805399213857603703537710517802128012956684198414036287272562321442875"
-    "430221090947272107";
+#include <algorithm>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+
+namespace pi {
+    std::optional<std::filesystem::path> cache_path() {
+        const auto* xdg = std::getenv("XDG_CACHE_HOME");
+        const auto* home = std::getenv("HOME");
+        if (xdg != nullptr && *xdg != '\0') {
+            return std::filesystem::path(xdg) / "circle-lang" / "pi-limbs";
+        }
+        if (home != nullptr && *home != '\0') {
+            return std::filesystem::path(home) / ".cache" / "circle-lang" / "pi-limbs";
+        }
+        return std::nullopt;
+    }
+
+    // A cache file is this header followed by its limbs.
+    struct Header {
+        std::uint64_t magic;
+        std::uint64_t count;
+        std::uint64_t checksum;
+    };
+    // "pilimbs" and a version.
+    const std::uint64_t MAGIC = 0x7069'6c69'6d62'7301;
+
+    std::uint64_t checksum(std::span<const std::uint64_t> limbs) {
+        auto h = std::uint64_t{0xcbf2'9ce4'8422'2325};
+        for (auto limb : limbs) {
+            h = (h ^ limb) * 0x100'0000'01b3;
+            h ^= h >> 29;
+        }
+        return h;
+    }
+
+    // The limbs in a cache file, if it's whole and agrees with the compiled table. Its last limb
+    // may round differently from the table's.
+    std::optional<std::span<const std::uint64_t>> parse(std::span<const std::byte> file) {
+        auto header = Header();
+        if (file.size() < sizeof(header)) {
+            return std::nullopt;
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+        auto body = file.subspan(sizeof(header));
+        if (header.magic != MAGIC || header.count < LIMB_COUNT ||
+            body.size() != header.count * sizeof(std::uint64_t)) {
+            return std::nullopt;
+        }
+        // The limbs are stored in native byte order, and follow the header at an aligned offset.
+        auto limbs = std::span(reinterpret_cast<const std::uint64_t*>(body.data()), header.count);
+        if (checksum(limbs) != header.checksum ||
+            !std::ranges::equal(limbs.first(LIMB_COUNT - 1),
+                                std::span(LIMBS).first(LIMB_COUNT - 1))) {
+            return std::nullopt;
+        }
+        return limbs;
+    }
+
+    void store(const std::filesystem::path& path, std::span<const std::uint64_t> limbs) {
+        auto ec = std::error_code();
+        std::filesystem::create_directories(path.parent_path(), ec);
+        // Write aside and rename, so that a concurrent run never maps a partial file.
+        auto tmp = path;
+        tmp += std::format(".{}", std::random_device()());
+        {
+            auto header = Header{.magic{MAGIC}, .count{limbs.size()}, .checksum{checksum(limbs)}};
+            auto file = std::ofstream(tmp, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(limbs.data()),
+                       static_cast<std::streamsize>(limbs.size_bytes()));
+            if (!file) {
+                std::filesystem::remove(tmp, ec);
+                return;
+            }
+        }
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp, ec);
+        }
+    }
+
+    // Bits of pi past the compiled table, read from a cache file at `path` or computed as they're
+    // asked for. It keeps every buffer it has handed out a span of, so those stay valid for as
+    // long as it lives. Growth is geometric, so that's at most twice the limbs of the last one.
+    class Extension {
+      private:
+        std::optional<std::filesystem::path> m_path;
+        std::mutex m_mutex;
+        std::vector<std::shared_ptr<const void>> m_held;
+        std::span<const std::uint64_t> m_current;
+
+        [[nodiscard]] std::optional<std::span<const std::uint64_t>> map(std::size_t count) {
+            namespace bip = boost::interprocess;
+            try {
+                auto file = bip::file_mapping(m_path->c_str(), bip::read_only);
+                auto region = std::make_shared<bip::mapped_region>(file, bip::read_only);
+                auto limbs = parse(std::span(static_cast<const std::byte*>(region->get_address()),
+                                             region->get_size()));
+                if (!limbs || limbs->size() < count) {
+                    return std::nullopt;
+                }
+                m_held.push_back(std::move(region));
+                return limbs;
+            } catch (const bip::interprocess_exception&) {
+                // Not cached yet, or unreadable, so compute them.
+                return std::nullopt;
+            }
+        }
+
+      public:
+        explicit Extension(std::optional<std::filesystem::path> path) : m_path{std::move(path)} {}
+
+        [[nodiscard]] std::span<const std::uint64_t> limbs(std::size_t bits) {
+            auto lock = std::scoped_lock(m_mutex);
+            auto count = (bits + 63) / 64 + 1;
+            if (count <= m_current.size()) {
+                return m_current;
+            }
+            if (m_path) {
+                if (auto mapped = map(count)) {
+                    m_current = *mapped;
+                    return m_current;
+                }
+            }
+
+            // Grow geometrically so that climbing precisions don't recompute every time.
+            auto held = m_current.empty() ? TABLE_BITS : (m_current.size() - 1) * 64;
+            auto target = std::min(std::max((count - 1) * 64, 2 * held), MAX_BITS);
+            auto generated = std::make_shared<const std::vector<std::uint64_t>>(chudnovsky(target));
+            m_current = *generated;
+            m_held.push_back(std::move(generated));
+            if (m_path) {
+                store(*m_path, m_current);
+            }
+            return m_current;
+        }
+    };
+
+    std::span<const std::uint64_t> limbs(std::size_t bits) {
+        assert(bits <= MAX_BITS);
+        if (bits <= TABLE_BITS) {
+            return LIMBS;
+        }
+        static auto extension = Extension(cache_path());
+        return extension.limbs(bits);
+    }
+} // namespace pi
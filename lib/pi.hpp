@@ -1,4 +1,36 @@
 #pragma once
 
-const int PI_DIGITS = 65536;
-extern const char* const PI;
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pi {
+    // Fractional bits of pi compiled into LIMBS.
+    const std::size_t TABLE_BITS = std::size_t{1} << 18;
+    // Bits past TABLE_BITS are computed on demand, up to this many.
+    const std::size_t MAX_BITS = std::size_t{1} << 22;
+
+    // floor(pi * 2^TABLE_BITS) as 64-bit limbs, most significant first, so LIMBS[0] is 3. The
+    // tables are generated at build time by gen/pi_table.cpp.
+    const std::size_t LIMB_COUNT = TABLE_BITS / 64 + 1;
+    extern const std::uint64_t LIMBS[LIMB_COUNT];
+
+    // pi^k * 2^POWER_BITS for k < POWER_COUNT, give or take one, laid out like LIMBS.
+    const std::size_t POWER_BITS = 2048;
+    const std::size_t POWER_COUNT = 9;
+    const std::size_t POWER_LIMBS = POWER_BITS / 64 + 1;
+    extern const std::uint64_t POWERS[POWER_COUNT][POWER_LIMBS];
+
+    // At least `bits` fractional bits of pi, laid out like LIMBS. Bits past the table are computed
+    // with the Chudnovsky series and cached in a checksummed file, which later runs memory map
+    // instead. The span stays valid for the rest of the run, and calls may come from any thread.
+    [[nodiscard]] std::span<const std::uint64_t> limbs(std::size_t bits);
+
+    // pi^power * 2^bits, give or take one, laid out like LIMBS and computed from scratch. `bits`
+    // must be a multiple of 64.
+    [[nodiscard]] std::vector<std::uint64_t> chudnovsky(std::size_t bits, unsigned power = 1);
+    // The first `count` decimal digits of pi, starting with the 3, computed from scratch.
+    [[nodiscard]] std::string decimal_digits(std::size_t count);
+} // namespace pi
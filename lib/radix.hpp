@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace radix {
+    // A persistent vector of a fixed size, kept as a tree of 32-way nodes with the items in the
+    // leaves. Copies share every node and changing an item copies only the shared nodes on its
+    // path, changing the rest in place, so both take a hop per 5 bits of the size. Up to 32 items
+    // are one flat leaf, and up to INLINE are held in the vector itself, without a node. Parts
+    // never set hold no nodes, and read as T().
+    template <typename T, std::size_t INLINE = 0> class Vector {
+      private:
+        static constexpr int BITS = 5;
+        static constexpr std::size_t WIDTH = std::size_t{1} << BITS;
+        static constexpr std::size_t MASK = WIDTH - 1;
+
+        // Every leaf is as deep as any other, so the depth tells what a node is: an array of
+        // items for a leaf, and else an array of the nodes below. Each holds as many as it covers.
+        using Ptr = std::shared_ptr<void>;
+
+        std::size_t m_size{0};
+        // Levels of nodes above the leaves.
+        int m_depth{0};
+        Ptr m_root;
+        // The items while there are no more than INLINE.
+        std::array<T, INLINE> m_inline{};
+
+        [[nodiscard]] bool is_inline() const { return m_size <= INLINE; }
+
+        // How many items or nodes the node at `level`, covering items from `start`, holds.
+        [[nodiscard]] std::size_t count(int level, std::size_t start) const {
+            auto span = std::size_t{1} << (level * BITS);
+            return std::min(WIDTH, (m_size - start + span - 1) / span);
+        }
+
+        template <typename U> static Ptr copy(const Ptr& node, std::size_t n) {
+            auto copied = std::make_shared<U[]>(n);
+            std::copy_n(static_cast<const U*>(node.get()), n, copied.get());
+            return copied;
+        }
+
+        // The node at `slot`, made if it isn't there, and copied first if anything else shares
+        // it. Either sets `moved`.
+        void own(Ptr& slot, int level, std::size_t start, bool& moved) {
+            auto n = count(level, start);
+            if (slot == nullptr) {
+                slot = level == 0 ? Ptr(std::make_shared<T[]>(n)) : Ptr(std::make_shared<Ptr[]>(n));
+                moved = true;
+            } else if (slot.use_count() > 1) {
+                slot = level == 0 ? copy<T>(slot, n) : copy<Ptr>(slot, n);
+                moved = true;
+            }
+        }
+
+        template <typename F>
+        void for_each(const Ptr& node, int level, std::size_t start, F& f) const {
+            if (node == nullptr) {
+                return;
+            }
+            auto n = count(level, start);
+            if (level == 0) {
+                const auto* items = static_cast<const T*>(node.get());
+                for (auto i = std::size_t{0}; i < n; i++) {
+                    f(start + i, items[i]);
+                }
+                return;
+            }
+            const auto* children = static_cast<const Ptr*>(node.get());
+            auto span = std::size_t{1} << (level * BITS);
+            for (auto i = std::size_t{0}; i < n; i++) {
+                for_each(children[i], level - 1, start + i * span, f);
+            }
+        }
+
+      public:
+        Vector() = default;
+        explicit Vector(std::size_t size) : m_size{size} {
+            while ((std::size_t{1} << ((m_depth + 1) * BITS)) < m_size) {
+                m_depth++;
+            }
+        }
+        // Holding `items`, which it takes all at once, a leaf and then a level at a time.
+        explicit Vector(std::vector<T>&& items) : Vector(items.size()) {
+            if (is_inline()) {
+                std::ranges::move(items, m_inline.begin());
+                return;
+            }
+            auto nodes = std::vector<Ptr>();
+            for (auto start = std::size_t{0}; start < m_size; start += WIDTH) {
+                auto n = count(0, start);
+                auto leaf = std::make_shared<T[]>(n);
+                std::move(items.begin() + start, items.begin() + start + n, leaf.get());
+                nodes.push_back(std::move(leaf));
+            }
+            for (auto level = 1; level <= m_depth; level++) {
+                auto above = std::vector<Ptr>();
+                for (auto start = std::size_t{0}; start < nodes.size(); start += WIDTH) {
+                    auto n = std::min(WIDTH, nodes.size() - start);
+                    auto node = std::make_shared<Ptr[]>(n);
+                    std::move(nodes.begin() + start, nodes.begin() + start + n, node.get());
+                    above.push_back(std::move(node));
+                }
+                nodes = std::move(above);
+            }
+            if (!nodes.empty()) {
+                m_root = std::move(nodes.front());
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const { return m_size; }
+
+        [[nodiscard]] const T& operator[](std::size_t i) const {
+            static const auto NONE = T();
+            if (is_inline()) {
+                return m_inline[i];
+            }
+            const auto* node = m_root.get();
+            for (auto level = m_depth; level > 0 && node != nullptr; level--) {
+                node = static_cast<const Ptr*>(node)[(i >> (level * BITS)) & MASK].get();
+            }
+            return node == nullptr ? NONE : static_cast<const T*>(node)[i & MASK];
+        }
+
+        // The item at `i`, made this vector's own to change. Sets `moved` if that puts it
+        // somewhere else, else it's where it was, and stays there until an edit moves it.
+        [[nodiscard]] T& edit(std::size_t i, bool& moved) {
+            if (is_inline()) {
+                return m_inline[i];
+            }
+            auto* slot = &m_root;
+            auto start = std::size_t{0};
+            for (auto level = m_depth;; level--) {
+                own(*slot, level, start, moved);
+                if (level == 0) {
+                    return static_cast<T*>(slot->get())[i & MASK];
+                }
+                auto child = (i >> (level * BITS)) & MASK;
+                start += child << (level * BITS);
+                slot = &static_cast<Ptr*>(slot->get())[child];
+            }
+        }
+
+        [[nodiscard]] T& edit(std::size_t i) {
+            auto moved = false;
+            return edit(i, moved);
+        }
+
+        // Calls `f` with the index of each item held by a node, and the item.
+        template <typename F> void for_each(F f) const {
+            if (is_inline()) {
+                for (auto i = std::size_t{0}; i < m_size; i++) {
+                    f(i, m_inline[i]);
+                }
+                return;
+            }
+            for_each(m_root, m_depth, 0, f);
+        }
+    };
+} // namespace radix
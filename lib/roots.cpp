@@ -0,0 +1,130 @@
+#include "roots.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace roots {
+    using ball::Int;
+
+    std::vector<Int> multiply(std::span<const Int> lhs, std::span<const Int> rhs) {
+        if (lhs.empty() || rhs.empty()) {
+            return {};
+        }
+        auto product = std::vector<Int>(lhs.size() + rhs.size() - 1);
+        for (auto i = 0; i < lhs.size(); i++) {
+            if (lhs[i].is_zero()) {
+                continue;
+            }
+            for (auto j = 0; j < rhs.size(); j++) {
+                product[i + j] += lhs[i] * rhs[j];
+            }
+        }
+        return product;
+    }
+
+    std::vector<Int> subtract(std::span<const Int> lhs, std::span<const Int> rhs) {
+        auto difference = std::vector<Int>(lhs.begin(), lhs.end());
+        difference.resize(std::max(lhs.size(), rhs.size()));
+        for (auto i = 0; i < rhs.size(); i++) {
+            difference[i] -= rhs[i];
+        }
+        return difference;
+    }
+
+    // p without its zero leading coefficients.
+    std::span<const Int> trim(std::span<const Int> p) {
+        while (!p.empty() && p.back().is_zero()) {
+            p = p.first(p.size() - 1);
+        }
+        return p;
+    }
+
+    int sign_at(std::span<const Int> p, const Int& x, int bits) {
+        p = trim(p);
+        if (p.empty()) {
+            return 0;
+        }
+        // 2^(bits * degree) * p(x * 2^-bits) by Horner's rule, scaling the lower coefficients
+        // instead of dividing by x's denominator.
+        auto sum = p.back();
+        auto scale = Int(1);
+        for (auto i = static_cast<int>(p.size()) - 2; i >= 0; i--) {
+            scale <<= bits;
+            sum = sum * x + p[i] * scale;
+        }
+        return sum.sign();
+    }
+
+    int count_between(std::span<const Int> p, const Int& lo, const Int& hi, int bits) {
+        p = trim(p);
+        if (p.size() <= 1) {
+            return 0;
+        }
+        auto degree = p.size() - 1;
+
+        // q(z) = 2^(bits * degree) * p((lo + z) * 2^-bits), so that the interval starts at 0.
+        auto q = std::vector<Int>{p.back()};
+        auto scale = Int(1);
+        for (auto i = static_cast<int>(degree) - 1; i >= 0; i--) {
+            scale <<= bits;
+            q.emplace_back(0);
+            for (auto j = q.size() - 1; j > 0; j--) {
+                q[j] = q[j] * lo + q[j - 1];
+            }
+            q[0] = q[0] * lo + p[i] * scale;
+        }
+
+        // q((hi - lo) * z), whose roots in (0, 1) are p's roots in (lo, hi).
+        auto width = hi - lo;
+        auto power = Int(1);
+        for (auto& c : q) {
+            c *= power;
+            power *= width;
+        }
+
+        // (1 + z)^degree * q(1 / (1 + z)) maps (0, 1) onto (0, infinity): reverse, then shift
+        // by one.
+        std::ranges::reverse(q);
+        for (auto i = 0; i < static_cast<int>(degree); i++) {
+            for (auto j = static_cast<int>(degree) - 1; j >= i; j--) {
+                q[j] += q[j + 1];
+            }
+        }
+
+        auto changes = 0;
+        auto last = 0;
+        for (const auto& c : q) {
+            auto s = c.sign();
+            if (s == 0) {
+                continue;
+            }
+            if (last != 0 && s != last) {
+                changes++;
+            }
+            last = s;
+        }
+        return changes;
+    }
+
+    std::optional<int> sign_at_pi(std::span<const Int> p) {
+        p = trim(p);
+        if (p.size() <= 1) {
+            return p.empty() ? 0 : p[0].sign();
+        }
+        auto bits = std::min(64, ball::max_bits());
+        while (true) {
+            auto pi = ball::pi(bits);
+            // pi is irrational, so it lies strictly inside its enclosure. Without a root in there
+            // p has the same sign everywhere in it, the midpoint included.
+            if (count_between(p, pi.mid - pi.rad, pi.mid + pi.rad, bits) == 0) {
+                auto sign = sign_at(p, pi.mid, bits);
+                assert(sign != 0);
+                return sign;
+            }
+            if (bits == ball::max_bits()) {
+                return std::nullopt;
+            }
+            bits = std::min(bits * 2, ball::max_bits());
+        }
+    }
+} // namespace roots
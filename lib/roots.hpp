@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ball.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+// Exact integer polynomials, lowest degree first.
+namespace roots {
+    [[nodiscard]] std::vector<ball::Int> multiply(std::span<const ball::Int> lhs,
+                                                  std::span<const ball::Int> rhs);
+    [[nodiscard]] std::vector<ball::Int> subtract(std::span<const ball::Int> lhs,
+                                                  std::span<const ball::Int> rhs);
+
+    // The sign of p(x * 2^-bits).
+    [[nodiscard]] int sign_at(std::span<const ball::Int> p, const ball::Int& x, int bits);
+    // An upper bound on the number of roots of p in (lo, hi) * 2^-bits, by Descartes' rule of
+    // signs. It has the parity of the actual count, so 0 and 1 are exact.
+    [[nodiscard]] int count_between(std::span<const ball::Int> p, const ball::Int& lo,
+                                    const ball::Int& hi, int bits);
+    // The sign of p(pi). Enclosures of pi only get finer while some root of p can't be ruled out
+    // of the current one, so the digits of pi needed depend on how close p's roots come to pi
+    // rather than on the size of its coefficients. nullopt if even ball::max_bits() isn't enough.
+    [[nodiscard]] std::optional<int> sign_at_pi(std::span<const ball::Int> p);
+} // namespace roots
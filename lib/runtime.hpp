@@ -1,53 +1,67 @@
 #pragma once
 
 #include "diagnostic.hpp"
+#include "hamt.hpp"
 #include "macros.hpp"
+#include "mpmc.hpp"
 #include "number.hpp"
 #include "parser.hpp"
+#include "radix.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <boost/container/small_vector.hpp>
 #include <cmath>
 #include <iomanip>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_set>
+#include <utility>
+#include <variant>
 
 namespace runtime {
     template <bool DEBUG> class Obj;
+    template <bool DEBUG> class Ref;
     template <bool DEBUG> class Array;
     template <bool DEBUG> class Index;
     template <bool DEBUG> class Assign;
     template <bool DEBUG> class OperatorBinary;
     template <bool DEBUG> class OperatorUnary;
     template <bool DEBUG> class Number;
+    template <bool DEBUG> class Debugger;
+    template <bool DEBUG> class Executor;
+    template <bool DEBUG> class Reclaimer;
 
-    template <bool DEBUG> std::unique_ptr<Obj<DEBUG>> from_ast(ast::Node<ast::Any>&& node) {
-        auto range = node.range;
-        return std::visit(
-            [&]<typename T>(T&& t) -> std::unique_ptr<Obj<DEBUG>> {
-                static_assert(std::is_same_v<T, std::decay_t<T>>);
-                if constexpr (std::is_same_v<T, ast::Array>) {
-                    return std::make_unique<Array<DEBUG>>(std::forward<ast::Array>(t), range);
-                } else if constexpr (std::is_same_v<T, ast::Assign>) {
-                    return std::make_unique<Assign<DEBUG>>(std::forward<ast::Assign>(t), range);
-                } else if constexpr (std::is_same_v<T, ast::Index>) {
-                    return std::make_unique<Index<DEBUG>>(std::forward<ast::Index>(t), range);
-                } else if constexpr (std::is_same_v<T, ast::OperatorBinary>) {
-                    return std::make_unique<OperatorBinary<DEBUG>>(
-                        std::forward<ast::OperatorBinary>(t), range);
-                } else if constexpr (std::is_same_v<T, ast::OperatorUnary>) {
-                    return std::make_unique<OperatorUnary<DEBUG>>(
-                        std::forward<ast::OperatorUnary>(t), range);
-                } else if constexpr (std::is_same_v<T, ast::Number>) {
-                    return std::make_unique<Number<DEBUG>>(std::forward<ast::Number>(t), range);
-                } else {
-                    static_assert(false, "Not exhaustive");
-                }
-            },
-            std::move(*node.t));
-    }
+    // Which final class an Obj is, so that checking it is a byte compare.
+    enum class Kind : std::uint8_t {
+        array,
+        index,
+        assign,
+        operator_binary,
+        operator_unary,
+        number,
+        std_input,
+        std_output,
+        std_decompose,
+    };
+
+    // Calls the evaluate or execute of the final class that `obj` is, found by its kind, so the
+    // call needs no vtable.
+    template <bool DEBUG> Ref<DEBUG> evaluate(const Obj<DEBUG>& obj, const Array<DEBUG>& gca);
+    template <bool DEBUG>
+    void execute(const Obj<DEBUG>& obj, Array<DEBUG>& gca, std::istream& in, std::ostream& out,
+                 std::ostream& err, Debugger<DEBUG>& debugger);
+
+    // Converts from a stack of tasks rather than by recursion, so any depth of nesting converts in
+    // constant native stack.
+    template <bool DEBUG> std::shared_ptr<const Obj<DEBUG>> from_ast(ast::Node<ast::Any>&& node);
 
     inline std::vector<std::string> split(std::string s, const std::string& delimiter) {
         std::vector<std::string> tokens;
@@ -133,13 +147,121 @@ c: continue
                 m_arr_level--;
             }
         }
-        void execute(const std::unique_ptr<Obj<DEBUG>>& obj, const Array<DEBUG>& gca,
-                     std::istream& in, std::ostream& out, std::ostream& err);
+        void execute(const Obj<DEBUG>& obj, const Array<DEBUG>& gca, std::istream& in,
+                     std::ostream& out, std::ostream& err);
     };
 
-    template <bool DEBUG> class Obj {
+    // The source ranges of runtime objects. Only errors and the debugger read them, so objects hold
+    // a 32-bit id into here instead. Ids are counted, and reused once nothing holds them, so
+    // loading programs over and over doesn't grow it. The last holder may die on the reclaimer's
+    // thread, so slots never move: block k holds ids 2^k up to 2^(k+1).
+    class RangeTable {
       private:
-        std::optional<diag::Range> m_range;
+        struct Slot {
+            diag::Range range;
+            std::atomic<std::uint32_t> refs{0};
+        };
+
+        std::mutex m_mutex;
+        std::array<std::unique_ptr<Slot[]>, 32> m_blocks;
+        std::vector<std::uint32_t> m_free;
+        std::uint32_t m_next{1};
+
+        RangeTable() = default;
+
+        [[nodiscard]] Slot& slot(std::uint32_t id) {
+            auto block = std::bit_width(id) - 1;
+            return m_blocks[block][id - (1U << block)];
+        }
+
+      public:
+        // Never destroyed, as objects held by other statics may outlive it.
+        [[nodiscard]] static RangeTable& instance() {
+            static auto& table = *new RangeTable();
+            return table;
+        }
+
+        [[nodiscard]] std::uint32_t add(const diag::Range& range) {
+            auto lock = std::scoped_lock(m_mutex);
+            auto id = m_next;
+            if (m_free.empty()) {
+                auto block = std::bit_width(id) - 1;
+                if (id == 1U << block) {
+                    m_blocks[block] = std::make_unique<Slot[]>(1U << block);
+                }
+                m_next++;
+            } else {
+                id = m_free.back();
+                m_free.pop_back();
+            }
+            slot(id).range = range;
+            slot(id).refs.store(1, std::memory_order_relaxed);
+            return id;
+        }
+        // Only called by a holder of `id`, so it can't be freed meanwhile.
+        void acquire(std::uint32_t id) { slot(id).refs.fetch_add(1, std::memory_order_relaxed); }
+        void release(std::uint32_t id) {
+            if (slot(id).refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                auto lock = std::scoped_lock(m_mutex);
+                m_free.push_back(id);
+            }
+        }
+        [[nodiscard]] const diag::Range& range(std::uint32_t id) { return slot(id).range; }
+
+        // How many ids are held.
+        [[nodiscard]] std::size_t size() {
+            auto lock = std::scoped_lock(m_mutex);
+            return m_next - 1 - m_free.size();
+        }
+    };
+
+    // A counted hold on an id in the RangeTable. Id 0 is for objects without a range.
+    class RangeId {
+      private:
+        std::uint32_t m_id{0};
+
+      public:
+        RangeId() = default;
+        explicit RangeId(const std::optional<diag::Range>& range)
+            : m_id{range ? RangeTable::instance().add(*range) : 0} {}
+        RangeId(const RangeId& other) : m_id{other.m_id} {
+            if (m_id != 0) {
+                RangeTable::instance().acquire(m_id);
+            }
+        }
+        RangeId(RangeId&& other) noexcept : m_id{std::exchange(other.m_id, 0)} {}
+        RangeId& operator=(RangeId other) noexcept {
+            std::swap(m_id, other.m_id);
+            return *this;
+        }
+        ~RangeId() {
+            if (m_id != 0) {
+                RangeTable::instance().release(m_id);
+            }
+        }
+
+        [[nodiscard]] std::uint32_t id() const { return m_id; }
+        [[nodiscard]] std::optional<diag::Range> range() const {
+            if (m_id == 0) {
+                return std::nullopt;
+            }
+            return RangeTable::instance().range(m_id);
+        }
+    };
+
+    // Part of what debug_string prints: text, a level of indentation, or an object to print at an
+    // indentation.
+    template <bool DEBUG>
+    using Piece = std::variant<std::string, int, std::pair<const Obj<DEBUG>*, int>>;
+
+    // Objects are never changed once shared, so they share their children, and so can every array
+    // and expression that holds them. Copying one only copies its own node. Only an array that
+    // nothing else holds is changed, in place, by assigning into it.
+    template <bool DEBUG> class Obj : public std::enable_shared_from_this<Obj<DEBUG>> {
+      private:
+        // The kind goes last so that a derived class can put a byte in the padding after it.
+        RangeId m_range;
+        Kind m_kind;
 
       public:
         Obj(const Obj&) = delete;
@@ -148,16 +270,133 @@ c: continue
         Obj& operator=(Obj&&) = default;
         virtual ~Obj() = default;
 
-        explicit Obj(std::optional<diag::Range> range) : m_range{range} {}
+        Obj(Kind kind, std::optional<diag::Range> range)
+            : m_range{range}, m_kind{kind} {}
+        // For copies, which share the range of the original.
+        Obj(Kind kind, RangeId range) : m_range{std::move(range)}, m_kind{kind} {}
 
-        [[nodiscard]] std::optional<diag::Range> get_range() const { return m_range; }
+        [[nodiscard]] Kind kind() const { return m_kind; }
+        [[nodiscard]] const RangeId& range_id() const { return m_range; }
+        [[nodiscard]] std::optional<diag::Range> get_range() const { return m_range.range(); }
 
         virtual void execute(Array<DEBUG>& gca, std::istream& in, std::ostream& out,
-                             std::ostream& err, Debugger<DEBUG>& debugger) = 0;
-        [[nodiscard]] virtual std::unique_ptr<Obj<DEBUG>>
-        evaluate(const Array<DEBUG>& gca) const = 0;
+                             std::ostream& err, Debugger<DEBUG>& debugger) const = 0;
+        [[nodiscard]] virtual Ref<DEBUG> evaluate(const Array<DEBUG>& gca) const = 0;
         [[nodiscard]] virtual std::unique_ptr<Obj<DEBUG>> clone() const = 0;
-        [[nodiscard]] virtual std::string debug_string(int indent) const = 0;
+        // Appends the pieces this object prints as, leaving its children to be printed later.
+        virtual void print(std::vector<Piece<DEBUG>>& pieces, int indent) const = 0;
+
+        // Prints from a stack of pieces rather than by recursion, so any depth of nesting prints in
+        // constant native stack.
+        [[nodiscard]] std::string debug_string(int indent) const {
+            auto ss = std::stringstream();
+            auto stack = std::vector<Piece<DEBUG>>{std::pair(this, indent)};
+            auto pieces = std::vector<Piece<DEBUG>>();
+            while (!stack.empty()) {
+                auto piece = std::move(stack.back());
+                stack.pop_back();
+                if (const auto* text = std::get_if<std::string>(&piece)) {
+                    ss << *text;
+                } else if (const auto* level = std::get_if<int>(&piece)) {
+                    print_indent(ss, *level);
+                } else {
+                    const auto [obj, obj_indent] = std::get<std::pair<const Obj*, int>>(piece);
+                    pieces.clear();
+                    obj->print(pieces, obj_indent);
+                    std::move(pieces.rbegin(), pieces.rend(), std::back_inserter(stack));
+                }
+            }
+            return ss.str();
+        }
+    };
+
+    // Drops `obj` on this thread. The outermost call frees whatever comes loose from a stack of its
+    // own. Destructors calling destructors would take native stack per level of nesting, this
+    // takes a constant amount.
+    template <bool DEBUG> void drain(std::shared_ptr<const Obj<DEBUG>>&& obj) {
+        thread_local auto pending = std::vector<std::shared_ptr<const Obj<DEBUG>>>();
+        thread_local auto draining = false;
+        if (obj == nullptr) {
+            return;
+        }
+        pending.push_back(std::move(obj));
+        if (draining) {
+            return;
+        }
+        draining = true;
+        while (!pending.empty()) {
+            auto last = std::move(pending.back());
+            pending.pop_back();
+            last.reset();
+        }
+        draining = false;
+    }
+
+    // Drops `obj`, which objects let go of their children through. A big array that nothing else
+    // holds is freed on the Reclaimer's thread.
+    template <bool DEBUG> void reclaim(std::shared_ptr<const Obj<DEBUG>>&& obj) {
+        if (obj != nullptr && obj.use_count() == 1 && Reclaimer<DEBUG>::wants(*obj) &&
+            Reclaimer<DEBUG>::instance().try_push(std::move(obj))) {
+            return;
+        }
+        drain<DEBUG>(std::move(obj));
+    }
+
+    // `obj` as a T, or null if it isn't one.
+    template <typename T, bool DEBUG> const T* as(const Obj<DEBUG>* obj) {
+        return obj != nullptr && obj->kind() == T::KIND ? static_cast<const T*>(obj) : nullptr;
+    }
+
+    // What evaluating an expression gives. It borrows the object if it is stored in the GCA or in
+    // the code, as neither changes during an evaluation. A number the evaluation computed is held
+    // inline, so arithmetic never makes an Obj.
+    template <bool DEBUG> class Ref {
+      private:
+        std::variant<const Obj<DEBUG>*, std::shared_ptr<const Obj<DEBUG>>, number::Value> m_ref;
+
+      public:
+        explicit Ref(const Obj<DEBUG>& obj) : m_ref{&obj} {}
+        explicit Ref(std::shared_ptr<const Obj<DEBUG>> obj) : m_ref{std::move(obj)} {}
+        explicit Ref(number::Value&& value) : m_ref{std::move(value)} {}
+
+        // Null for a number held inline.
+        [[nodiscard]] const Obj<DEBUG>* get() const {
+            if (const auto* obj = std::get_if<const Obj<DEBUG>*>(&m_ref)) {
+                return *obj;
+            }
+            if (const auto* owned = std::get_if<std::shared_ptr<const Obj<DEBUG>>>(&m_ref)) {
+                return owned->get();
+            }
+            return nullptr;
+        }
+        // Null if it isn't a number.
+        [[nodiscard]] const number::Value* as_number() const {
+            if (const auto* value = std::get_if<number::Value>(&m_ref)) {
+                return value;
+            }
+            const auto* num = as<Number<DEBUG>>(get());
+            return num == nullptr ? nullptr : &num->get_value();
+        }
+        [[nodiscard]] bool is_owned() const {
+            return !std::holds_alternative<const Obj<DEBUG>*>(m_ref);
+        }
+
+        // For keeping the result past a change to the GCA, such as storing it.
+        [[nodiscard]] std::shared_ptr<const Obj<DEBUG>> share() && {
+            if (auto* value = std::get_if<number::Value>(&m_ref)) {
+                return std::make_shared<const Number<DEBUG>>(std::move(*value), std::nullopt);
+            }
+            if (auto* owned = std::get_if<std::shared_ptr<const Obj<DEBUG>>>(&m_ref)) {
+                return std::move(*owned);
+            }
+            return std::get<const Obj<DEBUG>*>(m_ref)->shared_from_this();
+        }
+        [[nodiscard]] std::string debug_string(int indent) const {
+            if (const auto* value = std::get_if<number::Value>(&m_ref)) {
+                return diag::to_string(*value);
+            }
+            return get()->debug_string(indent);
+        }
     };
 
     inline void throw_index_non_array(diag::Range range) {
@@ -169,246 +408,584 @@ c: continue
             std::format("{} Attempting to index an array with a non number.", range.to_string())}};
     }
 
-    template <bool DEBUG> class Array : public Obj<DEBUG> {
+    template <bool DEBUG> class Array final : public Obj<DEBUG> {
+      public:
+        static constexpr Kind KIND = Kind::array;
+
       private:
+        // An element at an integer multiple of pi modulo the length, which is all an array
+        // literal has. Unset while `value` is null.
+        struct Dense {
+            std::shared_ptr<const Obj<DEBUG>> value;
+
+            Dense() = default;
+            explicit Dense(std::shared_ptr<const Obj<DEBUG>> value) : value{std::move(value)} {}
+            Dense(const Dense&) = default;
+            Dense(Dense&&) noexcept = default;
+            Dense& operator=(const Dense&) = default;
+            Dense& operator=(Dense&&) noexcept = default;
+            ~Dense() { reclaim<DEBUG>(std::move(value)); }
+        };
+        // Any other element. No such index is equal to an integer multiple of pi, as they differ
+        // by a multiple of length * pi.
+        struct Element {
+            // The hash of `index`.
+            std::uint64_t hash;
+            number::Value index;
+            std::shared_ptr<const Obj<DEBUG>> value;
+
+            Element(std::uint64_t hash, number::Value&& index,
+                    std::shared_ptr<const Obj<DEBUG>> value)
+                : hash{hash}, index{std::move(index)}, value{std::move(value)} {}
+            // For copying the trie leaf it's in, which then shares the value.
+            Element(const Element& other)
+                : hash{other.hash}, index{other.index.clone()}, value{other.value} {}
+            Element(Element&&) noexcept = default;
+            Element& operator=(const Element&) = delete;
+            Element& operator=(Element&& other) noexcept {
+                hash = other.hash;
+                index = std::move(other.index);
+                reclaim<DEBUG>(std::exchange(value, std::move(other.value)));
+                return *this;
+            }
+            ~Element() { reclaim<DEBUG>(std::move(value)); }
+        };
+        // Frames, vec headers and small records are no longer than this, and hold their elements
+        // in the block shared by copies, with no nodes of their own.
+        static constexpr std::size_t INLINE = 4;
+        using DenseVector = radix::Vector<Dense, INLINE>;
+        struct Elements {
+            // Renewed whenever an element may have moved, and never shared by two blocks, see
+            // Cache.
+            std::uint64_t stamp{next_stamp()};
+            // How many of `dense` are set.
+            std::size_t count{0};
+            // By slot. Copies share its nodes, so copying an array copies only the nodes along
+            // the paths of the slots it then changes.
+            DenseVector dense;
+            hamt::Map<Element> sparse;
+        };
+
         int m_length;
-        std::unordered_map<number::Index, std::unique_ptr<Obj<DEBUG>>> m_elements;
+        // Shared with every copy of this array until one of them changes, see `own`.
+        std::shared_ptr<Elements> m_elements;
 
       public:
-        Array(ast::Array&& node, diag::Range range)
-            : Obj<DEBUG>(range), m_length{static_cast<int>(node.elements.size())} {
-            for (auto i = 0; i < node.elements.size(); i++) {
-                m_elements.emplace(number::Index(number::Value(i), m_length),
-                                   from_ast<DEBUG>(std::move(node.elements[i])));
+        // A lookup kept by whoever makes it with the same key every time. It keeps where the
+        // value is, so it reads whatever is stored there later, and is redone only when an
+        // element of the array it was made in may have moved since.
+        class Cache {
+          private:
+            std::uint64_t m_stamp{0};
+            const std::shared_ptr<const Obj<DEBUG>>* m_value{nullptr};
+
+            friend class Array;
+        };
+
+      private:
+        Array(const Array& other)
+            : Obj<DEBUG>(KIND, other.range_id()), m_length{other.m_length},
+              m_elements{other.m_elements} {}
+
+        static std::uint64_t next_stamp() {
+            static auto stamp = std::atomic<std::uint64_t>{0};
+            return stamp.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        static std::shared_ptr<Elements> make_elements(std::size_t length) {
+            auto elements = std::make_shared<Elements>();
+            elements->dense = DenseVector(length);
+            return elements;
+        }
+
+        // The elements, copied first if another array shares them, which shares their nodes
+        // rather than copying them, so it takes O(1). Copying them sets `moved`.
+        Elements& own(bool& moved) {
+            if (m_elements.use_count() > 1) {
+                m_elements = std::make_shared<Elements>(std::as_const(*m_elements));
+                moved = true;
             }
+            return *m_elements;
         }
-        Array(int length, std::optional<diag::Range> range) : Obj<DEBUG>(range), m_length{length} {}
 
-        void insert(std::vector<diag::WithInfo<number::Value>>&& indices,
-                    std::unique_ptr<Obj<DEBUG>> v) {
-            auto* walk = this;
-            auto last = std::move(indices.back());
-            indices.pop_back();
-            for (const auto& index : indices) {
-                auto e = walk->m_elements.find(number::Index::make_ref(index.t, walk->m_length));
-                if (e == walk->m_elements.end()) {
-                    throw_index_non_array(index.range);
-                }
-                walk = dynamic_cast<Array*>(e->second.get());
-                if (walk == nullptr) {
-                    throw_index_non_array(index.range);
+        // Renews the stamp after a change that `moved` any element, so lookups cached before
+        // are redone. Replacing a value in place leaves them good.
+        void changed(bool moved) {
+            if (moved) {
+                m_elements->stamp = next_stamp();
+            }
+        }
+
+        // The multiple of pi that `i` is, modulo the length.
+        [[nodiscard]] std::optional<int> dense_slot(const number::Value& i) const {
+            if (m_length <= 0) {
+                return std::nullopt;
+            }
+            auto multiple = i.div_pi();
+            if (!multiple) {
+                return std::nullopt;
+            }
+            auto slot = *multiple % m_length;
+            if (slot < 0) {
+                slot += m_length;
+            }
+            return slot.to_int();
+        }
+
+        // Where the value at `i` is kept, or null if it's nowhere.
+        [[nodiscard]] const std::shared_ptr<const Obj<DEBUG>>* find(const number::Value& i) const {
+            if (auto slot = dense_slot(i)) {
+                return &m_elements->dense[*slot].value;
+            }
+            auto same = [&](const Element& e) { return number::index_equal(e.index, i, m_length); };
+            const auto* e = m_elements->sparse.find(number::hash(i, m_length), same);
+            return e == nullptr ? nullptr : &e->value;
+        }
+
+        [[nodiscard]] const std::shared_ptr<const Obj<DEBUG>>* find(const number::Value& i,
+                                                                    Cache& cache) const {
+            if (cache.m_stamp != m_elements->stamp) {
+                cache.m_stamp = m_elements->stamp;
+                cache.m_value = find(i);
+            }
+            return cache.m_value;
+        }
+
+        [[nodiscard]] static const std::shared_ptr<const Obj<DEBUG>>&
+        value_of(const std::shared_ptr<const Obj<DEBUG>>* value) {
+            // Unset elements read as pi.
+            static const auto UNSET = std::shared_ptr<const Obj<DEBUG>>(
+                std::make_shared<const Number<DEBUG>>(number::Value(1), std::nullopt));
+            return value == nullptr || *value == nullptr ? UNSET : *value;
+        }
+
+        void set(const number::Value& i, std::shared_ptr<const Obj<DEBUG>> v) {
+            auto moved = false;
+            auto& elements = own(moved);
+            if (auto slot = dense_slot(i)) {
+                auto& dense = elements.dense.edit(*slot, moved);
+                if (dense.value == nullptr) {
+                    elements.count++;
                 }
+                changed(moved);
+                reclaim<DEBUG>(std::exchange(dense.value, std::move(v)));
+                return;
             }
-            walk->m_elements.insert_or_assign(number::Index(std::move(last.t), walk->m_length),
-                                              std::move(v));
+            auto hash = number::hash(i, m_length);
+            auto same = [&](const Element& e) { return number::index_equal(e.index, i, m_length); };
+            moved |= elements.sparse.set(Element(hash, i.clone(), std::move(v)), same);
+            changed(moved);
+        }
+
+        // Where the value at `i`, which has to be set, is kept, made this array's own to change.
+        [[nodiscard]] std::shared_ptr<const Obj<DEBUG>>& edit(const number::Value& i) {
+            auto moved = false;
+            auto& elements = own(moved);
+            auto same = [&](const Element& e) { return number::index_equal(e.index, i, m_length); };
+            auto slot = dense_slot(i);
+            auto& value = slot ? elements.dense.edit(*slot, moved).value
+                               : elements.sparse.edit(number::hash(i, m_length), same, moved).value;
+            changed(moved);
+            return value;
         }
-        [[nodiscard]] std::unique_ptr<Obj<DEBUG>> index(const number::Value& i) const {
-            auto e = m_elements.find(number::Index::make_ref(i, m_length));
-            if (e == m_elements.end()) {
-                return std::make_unique<Number<DEBUG>>(number::Value(1), std::nullopt);
+
+        // The array at `i`, made ready to change in place. Whichever of this and it is shared
+        // with anything else is copied first, so nothing else sees the change.
+        [[nodiscard]] Array& own_child(const number::Value& i) {
+            auto& slot = edit(i);
+            if (slot.use_count() > 1) {
+                auto copy = std::shared_ptr<const Obj<DEBUG>>(
+                    new Array(static_cast<const Array&>(*slot)));
+                reclaim<DEBUG>(std::exchange(slot, std::move(copy)));
             }
-            return e->second->clone();
+            // Arrays are never made const, only handed out as such.
+            return const_cast<Array&>(static_cast<const Array&>(*slot));
         }
 
-        void execute(Array<DEBUG>& gca, std::istream& in, std::ostream& out, std::ostream& err,
-                     Debugger<DEBUG>& debugger) override {
-            debugger.arr_enter();
-            const auto zero = number::Value(BigInt(0));
-            auto obj = index(zero);
-            auto first = obj->evaluate(gca);
-            debugger.execute(obj, gca, in, out, err);
-            auto* number = dynamic_cast<Number<DEBUG>*>(first.get());
-            while (number == nullptr || !number::equal(number->get_value(), zero)) {
-                for (auto i = 1; i < m_length; i++) {
-                    auto obj = index(number::Value(i));
-                    debugger.execute(obj, gca, in, out, err);
-                    obj->execute(gca, in, out, err, debugger);
+        friend class Index<DEBUG>;
+        friend class Executor<DEBUG>;
+
+        // Appends the elements at 0 to length - 1, at least one, in a single walk over them.
+        void plan(std::vector<const Obj<DEBUG>*>& out) const {
+            if (m_length <= 0) {
+                out.push_back(&at(number::Value(BigInt(0))));
+                return;
+            }
+            auto start = out.size();
+            out.resize(start + m_length, value_of(nullptr).get());
+            m_elements->dense.for_each([&](std::size_t i, const Dense& d) {
+                if (d.value != nullptr) {
+                    out[start + i] = d.value.get();
                 }
+            });
+        }
+
+      public:
+        Array(Array&&) noexcept = default;
+        Array(std::span<std::shared_ptr<const Obj<DEBUG>>> elements, RangeId range_id)
+            : Obj<DEBUG>(KIND, std::move(range_id)), m_length{static_cast<int>(elements.size())},
+              m_elements{std::make_shared<Elements>()} {
+            auto dense = std::vector<Dense>();
+            dense.reserve(elements.size());
+            for (auto& e : elements) {
+                dense.emplace_back(std::move(e));
+            }
+            m_elements->count = dense.size();
+            m_elements->dense = DenseVector(std::move(dense));
+        }
+        Array(ast::Array&& node, diag::Range range)
+            : Obj<DEBUG>(KIND, range), m_length{static_cast<int>(node.elements.size())},
+              m_elements{std::make_shared<Elements>()} {
+            auto dense = std::vector<Dense>();
+            dense.reserve(node.elements.size());
+            for (auto& e : node.elements) {
+                dense.emplace_back(from_ast<DEBUG>(std::move(e)));
+            }
+            m_elements->count = dense.size();
+            m_elements->dense = DenseVector(std::move(dense));
+        }
+        Array(int length, std::optional<diag::Range> range)
+            : Obj<DEBUG>(KIND, range), m_length{length},
+              m_elements{make_elements(std::max(length, 0))} {}
 
-                auto obj = index(zero);
-                first = obj->evaluate(gca);
-                debugger.execute(obj, gca, in, out, err);
-                number = dynamic_cast<Number<DEBUG>*>(first.get());
+        // Arrays along the path are changed in place, unless they're shared with anything else,
+        // which gets them copied first.
+        void insert(std::span<diag::WithInfo<number::Value>> indices,
+                    std::shared_ptr<const Obj<DEBUG>> v) {
+            auto* arr = this;
+            for (const auto& index : indices.first(indices.size() - 1)) {
+                if (as<Array>(value_of(arr->find(index.t)).get()) == nullptr) {
+                    throw_index_non_array(index.range);
+                }
+                arr = &arr->own_child(index.t);
             }
-            debugger.arr_exit();
+            arr->set(indices.back().t, std::move(v));
+        }
+
+        void insert(std::vector<diag::WithInfo<number::Value>>&& indices,
+                    std::shared_ptr<const Obj<DEBUG>> v) {
+            insert(std::span(indices), std::move(v));
+        }
+        // How many elements are set.
+        [[nodiscard]] std::size_t size() const {
+            return m_elements->count + m_elements->sparse.size();
+        }
+        // The stored element itself, which is shared rather than copied.
+        [[nodiscard]] std::shared_ptr<const Obj<DEBUG>> index(const number::Value& i) const {
+            return value_of(find(i));
         }
-        [[nodiscard]] std::unique_ptr<Obj<DEBUG>> evaluate(const Array& /*gca*/) const override {
-            return clone();
+        // The same, borrowed for as long as this array is unchanged.
+        [[nodiscard]] const Obj<DEBUG>& at(const number::Value& i) const {
+            return *value_of(find(i));
+        }
+        // The same, for a key that is always `i` with `cache`.
+        [[nodiscard]] const Obj<DEBUG>& at(const number::Value& i, Cache& cache) const {
+            return *value_of(find(i, cache));
+        }
+
+        void execute(Array<DEBUG>& gca, std::istream& in, std::ostream& out, std::ostream& err,
+                     Debugger<DEBUG>& debugger) const override {
+            Executor<DEBUG>(gca, in, out, err, debugger).run(*this);
+        }
+        [[nodiscard]] Ref<DEBUG> evaluate(const Array& /*gca*/) const override {
+            return Ref<DEBUG>(*this);
         }
         [[nodiscard]] std::unique_ptr<Obj<DEBUG>> clone() const override {
-            auto na = std::make_unique<Array<DEBUG>>(m_length, this->get_range());
-            for (const auto& [i, e] : m_elements) {
-                na->m_elements.emplace(i.clone(), e->clone());
+            return std::unique_ptr<Obj<DEBUG>>(new Array(*this));
+        }
+        void print(std::vector<Piece<DEBUG>>& pieces, int indent) const override {
+            pieces.emplace_back("((\n");
+            // Integer multiples of pi in order, then the rest.
+            auto add = [&](std::string key, const Obj<DEBUG>* value) {
+                pieces.emplace_back(indent + 1);
+                pieces.emplace_back(std::move(key) + ": ");
+                pieces.emplace_back(std::pair(value, indent + 1));
+                pieces.emplace_back(";\n");
+            };
+            m_elements->dense.for_each([&](std::size_t i, const Dense& d) {
+                if (d.value != nullptr) {
+                    add(diag::to_string(number::Value(static_cast<int>(i))), d.value.get());
+                }
+            });
+            m_elements->sparse.for_each(
+                [&](const Element& e) { add(diag::to_string(e.index), e.value.get()); });
+            pieces.emplace_back(indent);
+            pieces.emplace_back("))");
+        }
+    };
+
+    // Frees big arrays on a thread of its own, so that dropping one never stalls the interpreter.
+    // Only so many wait at once, and past that they're freed where they're dropped.
+    template <bool DEBUG> class Reclaimer {
+      private:
+        static constexpr std::size_t BACKLOG = 1024;
+        // Smaller arrays are freed quicker than they're handed over.
+        static constexpr std::size_t MIN_ELEMENTS = 64;
+
+        mpmc::Queue<std::shared_ptr<const Obj<DEBUG>>> m_queue{BACKLOG};
+        // Counts pushes, for the thread to wait on while the queue is empty.
+        std::atomic<std::uint32_t> m_pushes{0};
+        // Last, so that it's joined before the queue goes.
+        std::jthread m_thread;
+
+        static bool& on_thread() {
+            thread_local auto on = false;
+            return on;
+        }
+
+        void run(const std::stop_token& stop) {
+            on_thread() = true;
+            auto wake = std::stop_callback(stop, [this] {
+                m_pushes.fetch_add(1, std::memory_order_release);
+                m_pushes.notify_one();
+            });
+            while (true) {
+                auto pushes = m_pushes.load(std::memory_order_acquire);
+                while (auto obj = m_queue.try_pop()) {
+                    drain<DEBUG>(std::move(*obj));
+                }
+                if (stop.stop_requested()) {
+                    return;
+                }
+                m_pushes.wait(pushes, std::memory_order_acquire);
             }
-            return na;
         }
-        [[nodiscard]] std::string debug_string(int indent) const override {
-            auto ss = std::stringstream();
-            ss << "((\n";
-            for (const auto& [i, e] : m_elements) {
-                print_indent(ss, indent + 1);
-                ss << diag::to_string(i.get_value()) << ": " << e->debug_string(indent + 1)
-                   << ";\n";
-            }
-            print_indent(ss, indent);
-            ss << "))";
-            return ss.str();
+
+        Reclaimer() : m_thread{[this](const std::stop_token& stop) { run(stop); }} {}
+
+      public:
+        Reclaimer(const Reclaimer&) = delete;
+        Reclaimer(Reclaimer&&) = delete;
+        Reclaimer& operator=(const Reclaimer&) = delete;
+        Reclaimer& operator=(Reclaimer&&) = delete;
+        ~Reclaimer() = default;
+
+        static Reclaimer& instance() {
+            static auto reclaimer = Reclaimer();
+            return reclaimer;
+        }
+
+        [[nodiscard]] static bool wants(const Obj<DEBUG>& obj) {
+            const auto* arr = as<Array<DEBUG>>(&obj);
+            return arr != nullptr && arr->size() >= MIN_ELEMENTS && !on_thread();
+        }
+
+        // Leaves `obj` as it was if the backlog is full.
+        [[nodiscard]] bool try_push(std::shared_ptr<const Obj<DEBUG>>&& obj) {
+            if (!m_queue.try_push(std::move(obj))) {
+                return false;
+            }
+            m_pushes.fetch_add(1, std::memory_order_release);
+            m_pushes.notify_one();
+            return true;
         }
     };
 
-    template <bool DEBUG> class Index : public Obj<DEBUG> {
+    template <bool DEBUG> class Index final : public Obj<DEBUG> {
+      public:
+        static constexpr Kind KIND = Kind::index;
+
       private:
-        std::optional<std::unique_ptr<Obj<DEBUG>>> m_subject;
-        std::unique_ptr<Obj<DEBUG>> m_index;
-        Index(std::optional<std::unique_ptr<Obj<DEBUG>>>&& subject,
-              std::unique_ptr<Obj<DEBUG>>&& index, diag::Range range)
-            : Obj<DEBUG>{range}, m_subject{std::move(subject)}, m_index{std::move(index)} {}
+        // Null for the GCA.
+        std::shared_ptr<const Obj<DEBUG>> m_subject;
+        std::shared_ptr<const Obj<DEBUG>> m_index;
 
       public:
-        Index(ast::Index&& node, diag::Range range)
-            : Obj<DEBUG>(range),
-              m_subject{node.subject ? std::make_optional(from_ast<DEBUG>(std::move(*node.subject)))
-                                     : std::nullopt},
-              m_index{from_ast<DEBUG>(std::move(node.index))} {}
-
-        [[nodiscard]] std::optional<std::vector<diag::WithInfo<number::Value>>>
-        get_gca_location(const Array<DEBUG>& gca) const {
-            auto index = m_index->evaluate(gca);
-            auto* ind_num = dynamic_cast<Number<DEBUG>*>(index.get());
+        // From the children, converted already or shared with the Index copied.
+        Index(std::shared_ptr<const Obj<DEBUG>> subject, std::shared_ptr<const Obj<DEBUG>> index,
+              RangeId range_id)
+            : Obj<DEBUG>{KIND, std::move(range_id)}, m_subject{std::move(subject)},
+              m_index{std::move(index)} {}
+        Index(const Index&) = delete;
+        Index(Index&&) = delete;
+        Index& operator=(const Index&) = delete;
+        Index& operator=(Index&&) = delete;
+        ~Index() override {
+            reclaim<DEBUG>(std::move(m_subject));
+            reclaim<DEBUG>(std::move(m_index));
+        }
+
+        // What this indexes in `arr`. A literal key keeps its lookup cached.
+        [[nodiscard]] const Obj<DEBUG>& element_of(const Array<DEBUG>& arr,
+                                                   const Array<DEBUG>& gca) const {
+            if (const auto* key = as<Number<DEBUG>>(m_index.get())) {
+                return arr.at(key->get_value(), key->lookup());
+            }
+            auto index = runtime::evaluate(*m_index, gca);
+            const auto* ind_num = index.as_number();
             if (ind_num == nullptr) {
                 assert(this->get_range());
                 throw_index_non_number(*this->get_range());
             }
-            if (m_subject) {
-                auto* subject = dynamic_cast<Index*>(m_subject->get());
-                if (subject == nullptr) {
-                    if (dynamic_cast<Array<DEBUG>*>(m_subject->get()) == nullptr) {
-                        assert(this->get_range());
-                        throw_index_non_array(*this->get_range());
+            return arr.at(*ind_num);
+        }
+
+        // Stores `v` where this indexes the GCA, or nowhere for a path starting at an array
+        // literal. The indices are evaluated from the outermost in, then the arrays on the path
+        // are found in one walk down from the GCA, and changed on a second, copying only those
+        // shared with anything else.
+        void assign(Array<DEBUG>& gca, std::shared_ptr<const Obj<DEBUG>> v) const {
+            struct Level {
+                const Index* index;
+                Ref<DEBUG> key;
+                // What `key` indexes, found on the way down.
+                const Array<DEBUG>* array;
+            };
+            // Paths are rarely deeper than this, so it's kept on the stack.
+            auto path = boost::container::small_vector<Level, 4>();
+            for (const auto* level = this;;) {
+                auto key = runtime::evaluate(*level->m_index, gca);
+                if (key.as_number() == nullptr) {
+                    assert(level->get_range());
+                    throw_index_non_number(*level->get_range());
+                }
+                path.push_back({.index{level}, .key{std::move(key)}, .array{nullptr}});
+                if (!level->m_subject) {
+                    break;
+                }
+                level = as<Index>(level->m_subject.get());
+                if (level == nullptr) {
+                    if (as<Array<DEBUG>>(path.back().index->m_subject.get()) == nullptr) {
+                        assert(path.back().index->get_range());
+                        throw_index_non_array(*path.back().index->get_range());
                     }
-                    return std::nullopt;
+                    return;
                 }
-                auto loc = subject->get_gca_location(gca);
-                // push back ind_num
-                if (loc) {
-                    assert(this->get_range());
-                    loc->emplace_back(*ind_num->get_range(), ind_num->get_value().clone());
+            }
+
+            // The last level indexes the GCA, and the first is the slot assigned.
+            path.back().array = &gca;
+            for (auto i = path.size() - 1; i > 0; i--) {
+                const auto* key = as<Number<DEBUG>>(path[i].index->m_index.get());
+                const auto* e = key == nullptr
+                                    ? path[i].array->find(*path[i].key.as_number())
+                                    : path[i].array->find(key->get_value(), key->lookup());
+                const auto* child = as<Array<DEBUG>>(Array<DEBUG>::value_of(e).get());
+                if (child == nullptr) {
+                    assert(path[i].index->m_index->get_range());
+                    throw_index_non_array(*path[i].index->m_index->get_range());
                 }
-                return loc;
-            } else {
-                auto loc = std::vector<diag::WithInfo<number::Value>>();
-                assert(this->get_range());
-                loc.emplace_back(*ind_num->get_range(), ind_num->get_value().clone());
-                return loc;
+                path[i - 1].array = child;
+            }
+            auto* arr = &gca;
+            for (auto i = path.size() - 1; i > 0; i--) {
+                arr = &arr->own_child(*path[i].key.as_number());
             }
+            arr->set(*path.front().key.as_number(), std::move(v));
         }
 
         [[nodiscard]] std::unique_ptr<Index> clone_specialize() const {
-            auto subject = std::optional<std::unique_ptr<Obj<DEBUG>>>();
-            if (m_subject) {
-                subject = (*m_subject)->clone();
-            }
-            assert(this->get_range());
-            return std::unique_ptr<Index>(
-                new Index(std::move(subject), m_index->clone(), *this->get_range()));
+            return std::unique_ptr<Index>(new Index(m_subject, m_index, this->range_id()));
         }
 
         void execute(Array<DEBUG>& gca, std::istream& in, std::ostream& out, std::ostream& err,
-                     Debugger<DEBUG>& debugger) override {
-            evaluate(gca)->execute(gca, in, out, err, debugger);
+                     Debugger<DEBUG>& debugger) const override {
+            Executor<DEBUG>(gca, in, out, err, debugger).run(*this);
         }
-        [[nodiscard]] std::unique_ptr<Obj<DEBUG>> evaluate(const Array<DEBUG>& gca) const override {
+        [[nodiscard]] Ref<DEBUG> evaluate(const Array<DEBUG>& gca) const override {
             const auto* arr = &gca;
             // declaring this early so that it live as long as arr
-            auto subject = std::unique_ptr<Obj<DEBUG>>();
+            auto subject = std::optional<Ref<DEBUG>>();
             if (m_subject) {
-                subject = (*m_subject)->evaluate(gca);
-                arr = dynamic_cast<Array<DEBUG>*>(subject.get());
+                subject = runtime::evaluate(*m_subject, gca);
+                arr = as<Array<DEBUG>>(subject->get());
             }
             if (arr == nullptr) {
                 assert(this->get_range());
                 throw_index_non_array(*this->get_range());
             }
-            auto index = m_index->evaluate(gca);
-            auto* ind_num = dynamic_cast<Number<DEBUG>*>(index.get());
-            if (ind_num == nullptr) {
-                assert(this->get_range());
-                throw_index_non_number(*this->get_range());
+            auto result = runtime::evaluate(element_of(*arr, gca), gca);
+            if (subject && subject->is_owned()) {
+                // The result may be part of the subject, which goes away here.
+                return Ref<DEBUG>(std::move(result).share());
             }
-            return arr->index(ind_num->get_value())->evaluate(gca);
+            return result;
         }
         [[nodiscard]] std::unique_ptr<Obj<DEBUG>> clone() const override {
             return clone_specialize();
         }
-        [[nodiscard]] std::string debug_string(int indent) const override {
+        void print(std::vector<Piece<DEBUG>>& pieces, int indent) const override {
             if (m_subject) {
-                return std::format("{}( {} )", (*m_subject)->debug_string(indent),
-                                   m_index->debug_string(indent));
-            } else {
-                return std::format("( {} )", m_index->debug_string(indent));
+                pieces.emplace_back(std::pair(m_subject.get(), indent));
             }
+            pieces.emplace_back("( ");
+            pieces.emplace_back(std::pair(m_index.get(), indent));
+            pieces.emplace_back(" )");
         }
     };
 
-    template <bool DEBUG> class Assign : public Obj<DEBUG> {
+    template <bool DEBUG> class Assign final : public Obj<DEBUG> {
+      public:
+        static constexpr Kind KIND = Kind::assign;
+
       private:
-        std::unique_ptr<Index<DEBUG>> m_lhs;
-        std::unique_ptr<Obj<DEBUG>> m_rhs;
-        Assign(std::unique_ptr<Index<DEBUG>>&& lhs, std::unique_ptr<Obj<DEBUG>>&& rhs,
-               std::optional<diag::Range> range)
-            : Obj<DEBUG>(range), m_lhs{std::move(lhs)}, m_rhs{std::move(rhs)} {}
+        std::shared_ptr<const Index<DEBUG>> m_lhs;
+        std::shared_ptr<const Obj<DEBUG>> m_rhs;
 
       public:
-        Assign(ast::Assign&& node, diag::Range range)
-            : Obj<DEBUG>(range),
-              m_lhs{std::make_unique<Index<DEBUG>>(std::move(*node.lhs.t), node.lhs.range)},
-              m_rhs{from_ast<DEBUG>(std::move(node.rhs))} {}
+        Assign(std::shared_ptr<const Index<DEBUG>> lhs, std::shared_ptr<const Obj<DEBUG>> rhs,
+               RangeId range_id)
+            : Obj<DEBUG>(KIND, std::move(range_id)), m_lhs{std::move(lhs)}, m_rhs{std::move(rhs)} {}
+        Assign(const Assign&) = delete;
+        Assign(Assign&&) = delete;
+        Assign& operator=(const Assign&) = delete;
+        Assign& operator=(Assign&&) = delete;
+        ~Assign() override {
+            reclaim<DEBUG>(std::move(m_lhs));
+            reclaim<DEBUG>(std::move(m_rhs));
+        }
 
         void execute(Array<DEBUG>& gca, std::istream& /*in*/, std::ostream& /*out*/,
-                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) override {
-            auto rhs = m_rhs->evaluate(gca);
-            auto gca_loc = m_lhs->get_gca_location(gca);
-            if (gca_loc) {
-                gca.insert(std::move(*gca_loc), std::move(rhs));
-            }
+                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) const override {
+            auto rhs = runtime::evaluate(*m_rhs, gca);
+            m_lhs->assign(gca, std::move(rhs).share());
         }
-        [[nodiscard]] std::unique_ptr<Obj<DEBUG>>
-        evaluate(const Array<DEBUG>& /*gca*/) const override {
-            return clone();
+        [[nodiscard]] Ref<DEBUG> evaluate(const Array<DEBUG>& /*gca*/) const override {
+            return Ref<DEBUG>(*this);
         }
         [[nodiscard]] std::unique_ptr<Obj<DEBUG>> clone() const override {
-            return std::unique_ptr<Obj<DEBUG>>(
-                new Assign(m_lhs->clone_specialize(), m_rhs->clone(), this->get_range()));
+            return std::unique_ptr<Obj<DEBUG>>(new Assign(m_lhs, m_rhs, this->range_id()));
         }
-        [[nodiscard]] std::string debug_string(int indent) const override {
-            return std::format("{} := {}", m_lhs->debug_string(indent),
-                               m_rhs->debug_string(indent));
+        void print(std::vector<Piece<DEBUG>>& pieces, int indent) const override {
+            pieces.emplace_back(std::pair(m_lhs.get(), indent));
+            pieces.emplace_back(" := ");
+            pieces.emplace_back(std::pair(m_rhs.get(), indent));
         }
     };
 
-    template <bool DEBUG> class OperatorBinary : public Obj<DEBUG> {
+    template <bool DEBUG> class OperatorBinary final : public Obj<DEBUG> {
+      public:
+        static constexpr Kind KIND = Kind::operator_binary;
+
       private:
         number::op::Binary m_kind;
-        std::unique_ptr<Obj<DEBUG>> m_lhs;
-        std::unique_ptr<Obj<DEBUG>> m_rhs;
-        OperatorBinary(number::op::Binary kind, std::unique_ptr<Obj<DEBUG>>&& lhs,
-                       std::unique_ptr<Obj<DEBUG>>&& rhs, std::optional<diag::Range> range)
-            : Obj<DEBUG>(range), m_kind{kind}, m_lhs{std::move(lhs)}, m_rhs{std::move(rhs)} {}
+        std::shared_ptr<const Obj<DEBUG>> m_lhs;
+        std::shared_ptr<const Obj<DEBUG>> m_rhs;
 
       public:
-        OperatorBinary(ast::OperatorBinary&& node, diag::Range range)
-            : Obj<DEBUG>(range), m_kind{node.kind}, m_lhs{from_ast<DEBUG>(std::move(node.lhs))},
-              m_rhs{from_ast<DEBUG>(std::move(node.rhs))} {}
+        OperatorBinary(number::op::Binary kind, std::shared_ptr<const Obj<DEBUG>> lhs,
+                       std::shared_ptr<const Obj<DEBUG>> rhs, RangeId range_id)
+            : Obj<DEBUG>(KIND, std::move(range_id)), m_kind{kind}, m_lhs{std::move(lhs)},
+              m_rhs{std::move(rhs)} {}
+        OperatorBinary(const OperatorBinary&) = delete;
+        OperatorBinary(OperatorBinary&&) = delete;
+        OperatorBinary& operator=(const OperatorBinary&) = delete;
+        OperatorBinary& operator=(OperatorBinary&&) = delete;
+        ~OperatorBinary() override {
+            reclaim<DEBUG>(std::move(m_lhs));
+            reclaim<DEBUG>(std::move(m_rhs));
+        }
 
-        void execute(Array<DEBUG>& gca, std::istream& in, std::ostream& out, std::ostream& err,
-                     Debugger<DEBUG>& debugger) override {
-            evaluate(gca)->execute(gca, in, out, err, debugger);
-        }
-        [[nodiscard]] std::unique_ptr<Obj<DEBUG>> evaluate(const Array<DEBUG>& gca) const override {
-            auto rhs = m_rhs->evaluate(gca);
-            auto* r = dynamic_cast<Number<DEBUG>*>(rhs.get());
-            auto lhs = m_lhs->evaluate(gca);
-            auto* l = dynamic_cast<Number<DEBUG>*>(lhs.get());
+        void execute(Array<DEBUG>& gca, std::istream& /*in*/, std::ostream& /*out*/,
+                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) const override {
+            // Operators give numbers, which do nothing when executed.
+            static_cast<void>(evaluate(gca));
+        }
+        [[nodiscard]] Ref<DEBUG> evaluate(const Array<DEBUG>& gca) const override {
+            auto rhs = runtime::evaluate(*m_rhs, gca);
+            const auto* r = rhs.as_number();
+            auto lhs = runtime::evaluate(*m_lhs, gca);
+            const auto* l = lhs.as_number();
             if (l == nullptr || r == nullptr) {
                 assert(this->get_range());
                 throw diag::RuntimeError{.msg{std::format("{} Can not operate on non number",
@@ -417,74 +994,71 @@ c: continue
 
             switch (m_kind) {
             case number::op::plus:
-                return std::make_unique<Number<DEBUG>>(l->get_value() + r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l + *r);
             case number::op::minus:
-                return std::make_unique<Number<DEBUG>>(l->get_value() - r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l - *r);
             case number::op::multiply:
-                return std::make_unique<Number<DEBUG>>(l->get_value() * r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l * *r);
             case number::op::divide:
-                return std::make_unique<Number<DEBUG>>(l->get_value() / r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l / *r);
             case number::op::bool_and:
-                return std::make_unique<Number<DEBUG>>(l->get_value() && r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l && *r);
             case number::op::bool_or:
-                return std::make_unique<Number<DEBUG>>(l->get_value() || r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l || *r);
             case number::op::equal:
-                return std::make_unique<Number<DEBUG>>(l->get_value() == r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l == *r);
             case number::op::not_equal:
-                return std::make_unique<Number<DEBUG>>(l->get_value() != r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l != *r);
             case number::op::smaller:
-                return std::make_unique<Number<DEBUG>>(l->get_value() < r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l < *r);
             case number::op::smaller_or_equal:
-                return std::make_unique<Number<DEBUG>>(l->get_value() <= r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l <= *r);
             case number::op::greater:
-                return std::make_unique<Number<DEBUG>>(l->get_value() > r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l > *r);
             case number::op::greater_or_equal:
-                return std::make_unique<Number<DEBUG>>(l->get_value() >= r->get_value(),
-                                                       std::nullopt);
+                return Ref<DEBUG>(*l >= *r);
             default:
                 assert(false && "Operator not found");
             }
+            std::unreachable();
         }
         [[nodiscard]] std::unique_ptr<Obj<DEBUG>> clone() const override {
             return std::unique_ptr<Obj<DEBUG>>(
-                new OperatorBinary(m_kind, m_lhs->clone(), m_rhs->clone(), this->get_range()));
+                new OperatorBinary(m_kind, m_lhs, m_rhs, this->range_id()));
         }
-        [[nodiscard]] std::string debug_string(int indent) const override {
-            return std::format("{} {} {}", m_lhs->debug_string(indent), diag::to_string(m_kind),
-                               m_rhs->debug_string(indent));
+        void print(std::vector<Piece<DEBUG>>& pieces, int indent) const override {
+            pieces.emplace_back(std::pair(m_lhs.get(), indent));
+            pieces.emplace_back(std::format(" {} ", diag::to_string(m_kind)));
+            pieces.emplace_back(std::pair(m_rhs.get(), indent));
         }
     };
 
-    template <bool DEBUG> class OperatorUnary : public Obj<DEBUG> {
+    template <bool DEBUG> class OperatorUnary final : public Obj<DEBUG> {
+      public:
+        static constexpr Kind KIND = Kind::operator_unary;
+
       private:
         number::op::Unary m_kind;
-        std::unique_ptr<Obj<DEBUG>> m_rhs;
-        OperatorUnary(number::op::Unary kind, std::unique_ptr<Obj<DEBUG>>&& rhs,
-                      std::optional<diag::Range> range)
-            : Obj<DEBUG>(range), m_kind{kind}, m_rhs{std::move(rhs)} {}
+        std::shared_ptr<const Obj<DEBUG>> m_rhs;
 
       public:
-        OperatorUnary(ast::OperatorUnary&& node, diag::Range range)
-            : Obj<DEBUG>(range), m_kind{node.kind}, m_rhs{from_ast<DEBUG>(std::move(node.rhs))} {}
+        OperatorUnary(number::op::Unary kind, std::shared_ptr<const Obj<DEBUG>> rhs,
+                      RangeId range_id)
+            : Obj<DEBUG>(KIND, std::move(range_id)), m_kind{kind}, m_rhs{std::move(rhs)} {}
+        OperatorUnary(const OperatorUnary&) = delete;
+        OperatorUnary(OperatorUnary&&) = delete;
+        OperatorUnary& operator=(const OperatorUnary&) = delete;
+        OperatorUnary& operator=(OperatorUnary&&) = delete;
+        ~OperatorUnary() override { reclaim<DEBUG>(std::move(m_rhs)); }
 
-        void execute(Array<DEBUG>& gca, std::istream& in, std::ostream& out, std::ostream& err,
-                     Debugger<DEBUG>& debugger) override {
-            evaluate(gca)->execute(gca, in, out, err, debugger);
+        void execute(Array<DEBUG>& gca, std::istream& /*in*/, std::ostream& /*out*/,
+                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) const override {
+            // Operators give numbers, which do nothing when executed.
+            static_cast<void>(evaluate(gca));
         }
-        [[nodiscard]] std::unique_ptr<Obj<DEBUG>> evaluate(const Array<DEBUG>& gca) const override {
-            auto rhs = m_rhs->evaluate(gca);
-            auto* r = dynamic_cast<Number<DEBUG>*>(rhs.get());
+        [[nodiscard]] Ref<DEBUG> evaluate(const Array<DEBUG>& gca) const override {
+            auto rhs = runtime::evaluate(*m_rhs, gca);
+            const auto* r = rhs.as_number();
             if (r == nullptr) {
                 assert(this->get_range());
                 throw diag::RuntimeError{.msg{std::format("{} Can not operate on non number",
@@ -493,78 +1067,94 @@ c: continue
 
             switch (m_kind) {
             case number::op::bool_not:
-                return std::make_unique<Number<DEBUG>>(!r->get_value(), std::nullopt);
+                return Ref<DEBUG>(!*r);
             }
+            assert(false && "Operator not found");
+            std::unreachable();
         }
         [[nodiscard]] std::unique_ptr<Obj<DEBUG>> clone() const override {
-            return std::unique_ptr<Obj<DEBUG>>(
-                new OperatorUnary(m_kind, m_rhs->clone(), this->get_range()));
+            return std::unique_ptr<Obj<DEBUG>>(new OperatorUnary(m_kind, m_rhs, this->range_id()));
         }
-        [[nodiscard]] std::string debug_string(int indent) const override {
-            return std::format("{}{}", diag::to_string(m_kind), m_rhs->debug_string(indent));
+        void print(std::vector<Piece<DEBUG>>& pieces, int indent) const override {
+            pieces.emplace_back(diag::to_string(m_kind));
+            pieces.emplace_back(std::pair(m_rhs.get(), indent));
         }
     };
 
-    template <bool DEBUG> class Number : public Obj<DEBUG> {
+    template <bool DEBUG> class Number final : public Obj<DEBUG> {
+      public:
+        static constexpr Kind KIND = Kind::number;
+
       private:
         number::Value m_value;
+        // For indexing with this as a literal key.
+        mutable typename Array<DEBUG>::Cache m_lookup;
+
+        Number(number::Value&& value, RangeId range_id)
+            : Obj<DEBUG>(KIND, std::move(range_id)), m_value{std::move(value)} {}
 
       public:
         Number(ast::Number&& node, diag::Range range)
-            : Obj<DEBUG>(range), m_value{std::move(node.value)} {}
+            : Obj<DEBUG>(KIND, range), m_value{std::move(node.value)} {}
         Number(number::Value&& value, std::optional<diag::Range> range)
-            : Obj<DEBUG>(range), m_value{std::move(value)} {}
+            : Obj<DEBUG>(KIND, range), m_value{std::move(value)} {}
 
         [[nodiscard]] const number::Value& get_value() const { return m_value; }
+        [[nodiscard]] typename Array<DEBUG>::Cache& lookup() const { return m_lookup; }
 
         void execute(Array<DEBUG>& /*gca*/, std::istream& /*in*/, std::ostream& /*out*/,
-                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) override {}
-        [[nodiscard]] std::unique_ptr<Obj<DEBUG>>
-        evaluate(const Array<DEBUG>& /*gca*/) const override {
-            return clone();
+                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) const override {}
+        [[nodiscard]] Ref<DEBUG> evaluate(const Array<DEBUG>& /*gca*/) const override {
+            return Ref<DEBUG>(*this);
         }
         [[nodiscard]] std::unique_ptr<Obj<DEBUG>> clone() const override {
-            return std::make_unique<Number<DEBUG>>(m_value.clone(), this->get_range());
+            return std::unique_ptr<Obj<DEBUG>>(new Number(m_value.clone(), this->range_id()));
         }
-        [[nodiscard]] std::string debug_string(int /*indent*/) const override {
-            return diag::to_string(m_value);
+        void print(std::vector<Piece<DEBUG>>& pieces, int /*indent*/) const override {
+            pieces.emplace_back(diag::to_string(m_value));
         }
     };
 
     template <typename T, bool DEBUG> class StdFun : public Obj<DEBUG> {
       public:
         // NOLINTNEXTLINE(bugprone-crtp-constructor-accessibility)
-        StdFun() : Obj<DEBUG>(std::nullopt) {}
-        [[nodiscard]] std::unique_ptr<Obj<DEBUG>>
-        evaluate(const Array<DEBUG>& /*gca*/) const override {
-            return clone();
+        StdFun() : Obj<DEBUG>(T::KIND, std::nullopt) {}
+        [[nodiscard]] Ref<DEBUG> evaluate(const Array<DEBUG>& /*gca*/) const override {
+            return Ref<DEBUG>(*this);
         }
         [[nodiscard]] std::unique_ptr<Obj<DEBUG>> clone() const override {
             return std::make_unique<T>();
         }
     };
 
-    template <bool DEBUG> class StdInput : public StdFun<StdInput<DEBUG>, DEBUG> {
+    template <bool DEBUG> class StdInput final : public StdFun<StdInput<DEBUG>, DEBUG> {
       public:
+        static constexpr Kind KIND = Kind::std_input;
+
         void execute(Array<DEBUG>& gca, std::istream& in, std::ostream& /*out*/,
-                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) override {
+                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) const override {
             auto chr = in.get();
             auto loc = std::vector<diag::WithInfo<number::Value>>();
             loc.emplace_back(diag::Range{}, number::Value("std_input_char"));
             gca.insert(std::move(loc),
                        std::make_unique<Number<DEBUG>>(number::Value(chr), std::nullopt));
         }
-        [[nodiscard]] std::string debug_string(int /*indent*/) const override {
-            return "std_input";
+        void print(std::vector<Piece<DEBUG>>& pieces, int /*indent*/) const override {
+            pieces.emplace_back("std_input");
         }
     };
 
-    template <bool DEBUG> class StdOutput : public StdFun<StdOutput<DEBUG>, DEBUG> {
+    template <bool DEBUG> class StdOutput final : public StdFun<StdOutput<DEBUG>, DEBUG> {
+      private:
+        inline static const auto KEY = number::Value("std_output_char");
+        mutable typename Array<DEBUG>::Cache m_lookup;
+
       public:
+        static constexpr Kind KIND = Kind::std_output;
+
         void execute(Array<DEBUG>& gca, std::istream& /*in*/, std::ostream& out,
-                     std::ostream& /*err*/, Debugger<DEBUG>& /*debug*/) override {
-            auto obj = gca.index(number::Value("std_output_char"));
-            auto* num = dynamic_cast<Number<DEBUG>*>(obj.get());
+                     std::ostream& /*err*/, Debugger<DEBUG>& /*debug*/) const override {
+            const auto* num = as<Number<DEBUG>>(&gca.at(KEY, m_lookup));
             if (num == nullptr) {
                 throw diag::RuntimeError{.msg{"(std_output_char) isn't a number."}};
             }
@@ -578,19 +1168,25 @@ c: continue
             }
             out << static_cast<char>(c->to_int());
         }
-        [[nodiscard]] std::string debug_string(int /*indent*/) const override {
-            return "std_output";
+        void print(std::vector<Piece<DEBUG>>& pieces, int /*indent*/) const override {
+            pieces.emplace_back("std_output");
         }
     };
 
-    template <bool DEBUG> class StdDecompose : public StdFun<StdDecompose<DEBUG>, DEBUG> {
+    template <bool DEBUG> class StdDecompose final : public StdFun<StdDecompose<DEBUG>, DEBUG> {
+      private:
+        inline static const auto KEY = number::Value("std_decompose_number");
+        mutable typename Array<DEBUG>::Cache m_lookup;
+
       public:
+        static constexpr Kind KIND = Kind::std_decompose;
+
         void execute(Array<DEBUG>& gca, std::istream& /*in*/, std::ostream& /*out*/,
-                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) override {
-            auto num = gca.index(number::Value("std_decompose_number"));
-            const auto& number = dynamic_cast<Number<DEBUG>*>(num.get())->get_value();
+                     std::ostream& /*err*/, Debugger<DEBUG>& /*debugger*/) const override {
+            const auto& number =
+                static_cast<const Number<DEBUG>&>(gca.at(KEY, m_lookup)).get_value();
 
-            auto insert = [&](const std::vector<BigInt>& ator, std::string_view index) {
+            auto insert = [&](const number::Coefficients& ator, std::string_view index) {
                 auto arr = Array<DEBUG>(static_cast<int>(std::max(ator.size(), 1UL)), std::nullopt);
                 if (ator.empty()) {
                     auto loc = std::vector<diag::WithInfo<number::Value>>();
@@ -614,8 +1210,231 @@ c: continue
             insert(number.get_numerator(), "std_decompose_numerator");
             insert(number.get_denominator(), "std_decompose_denominator");
         }
-        [[nodiscard]] std::string debug_string(int /*indent*/) const override {
-            return "std_decompose";
+        void print(std::vector<Piece<DEBUG>>& pieces, int /*indent*/) const override {
+            pieces.emplace_back("std_decompose");
+        }
+    };
+
+    template <bool DEBUG, typename F> decltype(auto) dispatch(const Obj<DEBUG>& obj, F&& f) {
+        switch (obj.kind()) {
+        case Kind::array:
+            return f(static_cast<const Array<DEBUG>&>(obj));
+        case Kind::index:
+            return f(static_cast<const Index<DEBUG>&>(obj));
+        case Kind::assign:
+            return f(static_cast<const Assign<DEBUG>&>(obj));
+        case Kind::operator_binary:
+            return f(static_cast<const OperatorBinary<DEBUG>&>(obj));
+        case Kind::operator_unary:
+            return f(static_cast<const OperatorUnary<DEBUG>&>(obj));
+        case Kind::number:
+            return f(static_cast<const Number<DEBUG>&>(obj));
+        case Kind::std_input:
+            return f(static_cast<const StdInput<DEBUG>&>(obj));
+        case Kind::std_output:
+            return f(static_cast<const StdOutput<DEBUG>&>(obj));
+        case Kind::std_decompose:
+            return f(static_cast<const StdDecompose<DEBUG>&>(obj));
+        }
+        assert(false && "Kind not found");
+        std::unreachable();
+    }
+
+    template <bool DEBUG> Ref<DEBUG> evaluate(const Obj<DEBUG>& obj, const Array<DEBUG>& gca) {
+        return dispatch(obj, [&](const auto& o) { return o.evaluate(gca); });
+    }
+
+    template <bool DEBUG>
+    void execute(const Obj<DEBUG>& obj, Array<DEBUG>& gca, std::istream& in, std::ostream& out,
+                 std::ostream& err, Debugger<DEBUG>& debugger) {
+        dispatch(obj, [&](const auto& o) { o.execute(gca, in, out, err, debugger); });
+    }
+
+    template <bool DEBUG> std::shared_ptr<const Obj<DEBUG>> from_ast(ast::Node<ast::Any>&& node) {
+        // A node whose `count` children have been taken out to convert. It's built from their
+        // results once they are.
+        struct Build {
+            ast::Node<ast::Any> node;
+            std::size_t count;
+        };
+        auto tasks = std::vector<std::variant<ast::Node<ast::Any>, Build>>();
+        tasks.emplace_back(std::move(node));
+        auto results = std::vector<std::shared_ptr<const Obj<DEBUG>>>();
+        while (!tasks.empty()) {
+            auto task = std::move(tasks.back());
+            tasks.pop_back();
+
+            if (auto* next = std::get_if<ast::Node<ast::Any>>(&task)) {
+                auto children = std::vector<ast::Node<ast::Any>>();
+                std::visit(
+                    [&]<typename T>(T& t) {
+                        if constexpr (std::is_same_v<T, ast::Array>) {
+                            std::ranges::move(t.elements, std::back_inserter(children));
+                        } else if constexpr (std::is_same_v<T, ast::Assign>) {
+                            children.push_back(
+                                ast::convert_node<ast::Index, ast::Any>(std::move(t.lhs)));
+                            children.push_back(std::move(t.rhs));
+                        } else if constexpr (std::is_same_v<T, ast::Index>) {
+                            if (t.subject) {
+                                children.push_back(std::move(*t.subject));
+                            }
+                            children.push_back(std::move(t.index));
+                        } else if constexpr (std::is_same_v<T, ast::OperatorBinary>) {
+                            children.push_back(std::move(t.lhs));
+                            children.push_back(std::move(t.rhs));
+                        } else if constexpr (std::is_same_v<T, ast::OperatorUnary>) {
+                            children.push_back(std::move(t.rhs));
+                        } else if constexpr (std::is_same_v<T, ast::Number>) {
+                        } else {
+                            static_assert(false, "Not exhaustive");
+                        }
+                    },
+                    *next->t);
+                tasks.emplace_back(Build{.node{std::move(*next)}, .count{children.size()}});
+                // The first child is converted, and its result pushed, first.
+                std::ranges::move(children.rbegin(), children.rend(), std::back_inserter(tasks));
+                continue;
+            }
+
+            auto& [built, count] = std::get<Build>(task);
+            auto children = std::span(results).last(count);
+            auto range = built.range;
+            auto obj = std::visit(
+                [&]<typename T>(T& t) -> std::shared_ptr<const Obj<DEBUG>> {
+                    if constexpr (std::is_same_v<T, ast::Number>) {
+                        return std::make_shared<Number<DEBUG>>(std::move(t), range);
+                    } else if constexpr (std::is_same_v<T, ast::Array>) {
+                        return std::make_shared<Array<DEBUG>>(children, RangeId(range));
+                    } else if constexpr (std::is_same_v<T, ast::Assign>) {
+                        return std::make_shared<Assign<DEBUG>>(
+                            std::static_pointer_cast<const Index<DEBUG>>(std::move(children[0])),
+                            std::move(children[1]), RangeId(range));
+                    } else if constexpr (std::is_same_v<T, ast::Index>) {
+                        if (t.subject) {
+                            return std::make_shared<Index<DEBUG>>(
+                                std::move(children[0]), std::move(children[1]), RangeId(range));
+                        }
+                        return std::make_shared<Index<DEBUG>>(nullptr, std::move(children[0]),
+                                                              RangeId(range));
+                    } else if constexpr (std::is_same_v<T, ast::OperatorBinary>) {
+                        return std::make_shared<OperatorBinary<DEBUG>>(
+                            t.kind, std::move(children[0]), std::move(children[1]),
+                            RangeId(range));
+                    } else if constexpr (std::is_same_v<T, ast::OperatorUnary>) {
+                        return std::make_shared<OperatorUnary<DEBUG>>(
+                            t.kind, std::move(children[0]), RangeId(range));
+                    } else {
+                        static_assert(false, "Not exhaustive");
+                    }
+                },
+                *built.t);
+            results.resize(results.size() - count);
+            results.push_back(std::move(obj));
+        }
+        return std::move(results.back());
+    }
+
+    // Runs arrays with a stack of its own rather than the native one, so however deep arrays nest
+    // or call each other, executing takes constant native stack.
+    template <bool DEBUG> class Executor {
+      private:
+        struct Frame {
+            const Array<DEBUG>* array;
+            // Set when nothing else is sure to keep the array alive, like an array read from the
+            // GCA, which it may overwrite while running. Holding it is all running it in place
+            // takes, as an array something else holds is copied rather than changed.
+            std::shared_ptr<const Obj<DEBUG>> hold;
+            // Where the array's elements start in m_plans, once its condition first holds.
+            std::optional<std::size_t> plan;
+            // The element to run next, where 0 is the condition.
+            int next;
+        };
+
+        Array<DEBUG>& m_gca;
+        std::istream& m_in;
+        std::ostream& m_out;
+        std::ostream& m_err;
+        Debugger<DEBUG>& m_debugger;
+        std::vector<Frame> m_frames;
+        // The elements of every array in m_frames, looked up once it's known to run its body.
+        // A running array is held by its frame, the code or the array it's written in, so it never
+        // changes, and these stay good for as long as it runs.
+        std::vector<const Obj<DEBUG>*> m_plans;
+        number::Value m_zero{BigInt(0)};
+
+        void push(const Array<DEBUG>& array, std::shared_ptr<const Obj<DEBUG>> hold) {
+            m_debugger.arr_enter();
+            m_frames.push_back({.array{&array}, .hold{std::move(hold)}, .plan{}, .next{0}});
+        }
+        void pop() {
+            if (m_frames.back().plan) {
+                m_plans.resize(*m_frames.back().plan);
+            }
+            // The array may have been overwritten while it ran, and this may be the last of it.
+            reclaim<DEBUG>(std::move(m_frames.back().hold));
+            m_frames.pop_back();
+            m_debugger.arr_exit();
+        }
+
+        // Arrays are pushed rather than run, everything else runs right away.
+        void step(const Obj<DEBUG>& obj) {
+            switch (obj.kind()) {
+            case Kind::array:
+                // Held by the array it is written in, or by whoever runs it.
+                push(static_cast<const Array<DEBUG>&>(obj), nullptr);
+                break;
+            case Kind::index: {
+                auto target = runtime::evaluate(obj, m_gca);
+                if (target.get() == nullptr) {
+                    break;
+                }
+                // Running it may change the GCA, which could drop it.
+                auto hold = std::move(target).share();
+                if (const auto* array = as<Array<DEBUG>>(hold.get())) {
+                    push(*array, std::move(hold));
+                } else {
+                    runtime::execute(*hold, m_gca, m_in, m_out, m_err, m_debugger);
+                }
+            } break;
+            default:
+                runtime::execute(obj, m_gca, m_in, m_out, m_err, m_debugger);
+            }
+        }
+
+      public:
+        Executor(Array<DEBUG>& gca, std::istream& in, std::ostream& out, std::ostream& err,
+                 Debugger<DEBUG>& debugger)
+            : m_gca{gca}, m_in{in}, m_out{out}, m_err{err}, m_debugger{debugger} {}
+
+        void run(const Obj<DEBUG>& obj) {
+            step(obj);
+            while (!m_frames.empty()) {
+                auto& frame = m_frames.back();
+                if (frame.next == 0) {
+                    // Calling an array that doesn't run costs one lookup.
+                    const auto& condition =
+                        frame.plan ? *m_plans[*frame.plan] : frame.array->at(m_zero);
+                    auto first = runtime::evaluate(condition, m_gca);
+                    m_debugger.execute(condition, m_gca, m_in, m_out, m_err);
+                    const auto* number = first.as_number();
+                    if (number != nullptr && number::equal(*number, m_zero)) {
+                        pop();
+                        continue;
+                    }
+                    frame.next = 1;
+                    if (!frame.plan) {
+                        frame.plan = m_plans.size();
+                        frame.array->plan(m_plans);
+                    }
+                }
+                if (frame.next >= frame.array->m_length) {
+                    frame.next = 0;
+                    continue;
+                }
+                const auto& obj = *m_plans[*frame.plan + frame.next++];
+                m_debugger.execute(obj, m_gca, m_in, m_out, m_err);
+                step(obj);
+            }
         }
     };
 
@@ -657,14 +1476,14 @@ c: continue
     };
 
     template <bool DEBUG>
-    void Debugger<DEBUG>::execute(const std::unique_ptr<Obj<DEBUG>>& obj, const Array<DEBUG>& gca,
-                                  std::istream& in, std::ostream& out, std::ostream& err) {
+    void Debugger<DEBUG>::execute(const Obj<DEBUG>& obj, const Array<DEBUG>& gca, std::istream& in,
+                                  std::ostream& out, std::ostream& err) {
         if constexpr (DEBUG) {
             auto print_line = [&](int line) {
                 out << "line " << std::setw(std::log10(m_lines.size()) + 1) << line + 1 << ": "
                     << m_lines[line] << '\n';
             };
-            auto range = obj->get_range();
+            auto range = obj.get_range();
             if (m_stepping_level.value_or(0) >= m_arr_level ||
                 (range && m_breakpoints.contains(range->start.line))) {
                 print_line(range->start.line);
@@ -720,8 +1539,8 @@ c: continue
                         }
                         for (auto&& e : std::move(parsed->elements)) {
                             try {
-                                out << from_ast<DEBUG>(std::move(e))->evaluate(gca)->debug_string(0)
-                                    << ";\n";
+                                auto obj = from_ast<DEBUG>(std::move(e));
+                                out << obj->evaluate(gca).debug_string(0) << ";\n";
                             } catch (const diag::RuntimeError& e) {
                                 err << e.msg << '\n';
                             }
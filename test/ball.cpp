@@ -0,0 +1,81 @@
+#include "lib/ball.cpp"
+#include "lib/pi.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(Ball, Arithmetic) {
+    auto a = ball::Ball{.mid{10}, .rad{1}};
+    auto b = ball::Ball{.mid{-3}, .rad{2}};
+    auto p = a * b;
+    EXPECT_EQ(p.mid, -30);
+    EXPECT_EQ(p.rad, 10 * 2 + 3 * 1 + 1 * 2);
+    EXPECT_EQ(ball::sign(p), -1);
+    EXPECT_EQ(ball::sign(a - b), 1);
+    EXPECT_EQ(ball::sign(b), -1);
+    EXPECT_EQ(ball::sign({.mid{1}, .rad{1}}), std::nullopt);
+
+    // 2.5 * 1.5 with 4 fractional bits
+    auto m = ball::multiply({.mid{40}, .rad{0}}, {.mid{24}, .rad{0}}, 4);
+    EXPECT_LE(m.mid - m.rad, 60);
+    EXPECT_GE(m.mid + m.rad, 60);
+
+    EXPECT_EQ(ball::from_decimal("123456789012345678901234567890", true),
+              ball::Int("-123456789012345678901234567890"));
+    EXPECT_EQ(ball::from_decimal("", false), 0);
+}
+
+TEST(Ball, PiPowers) {
+    // floor(pi^k * 10^20) for k = 0 ... 3
+    auto expected = std::vector<ball::Int>{
+        ball::Int("100000000000000000000"),
+        ball::Int("314159265358979323846"),
+        ball::Int("986960440108935861883"),
+        ball::Int("3100627668029982017547"),
+    };
+    for (auto bits : {96, 512, 4096, 100000}) {
+        const auto& powers = *ball::pi_powers(bits, expected.size());
+        ASSERT_GE(powers.size(), expected.size());
+        for (auto k = 0; k < expected.size(); k++) {
+            auto scale = pow(ball::Int(10), 20);
+            ball::Int lo = ((powers[k].mid - powers[k].rad) * scale) >> bits;
+            ball::Int hi = ((powers[k].mid + powers[k].rad) * scale) >> bits;
+            EXPECT_LE(lo, expected[k]) << bits << " " << k;
+            EXPECT_GE(hi, expected[k]) << bits << " " << k;
+            EXPECT_LE(powers[k].rad, 128) << bits << " " << k;
+        }
+    }
+    EXPECT_EQ(ball::pi_powers(96, 2), ball::pi_powers(96, 2));
+}
+
+TEST(Ball, PiPowersGrowth) {
+    // A table held across growth stays as it was.
+    auto small = ball::pi_powers(160, 2);
+    auto big = ball::pi_powers(160, 40);
+    ASSERT_GE(big->size(), 40);
+    EXPECT_EQ(small->size(), 2);
+    EXPECT_EQ((*small)[1].mid, (*big)[1].mid);
+
+    // And tables may be asked for from any thread.
+    auto threads = std::vector<std::jthread>();
+    for (auto t = 1; t <= 4; t++) {
+        threads.emplace_back([t] {
+            for (auto count = 1; count <= 64; count++) {
+                auto powers = ball::pi_powers(192, count * t);
+                EXPECT_GE(powers->size(), count * t);
+            }
+        });
+    }
+}
+
+TEST(Ball, Pi) {
+    auto digits = 400;
+    auto truncated = ball::Int(pi::decimal_digits(digits));
+    auto scale = pow(ball::Int(10), digits - 1);
+    for (auto bits : {64, 100, 1000}) {
+        // pi lies within [truncated, truncated + 1] / scale.
+        auto b = ball::pi(bits);
+        EXPECT_LT((b.mid - b.rad) * scale, (truncated + 1) << bits) << bits;
+        EXPECT_GT((b.mid + b.rad) * scale, truncated << bits) << bits;
+        EXPECT_LE(b.rad, 2);
+    }
+}
@@ -0,0 +1,117 @@
+#include "lib/hamt.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+    struct Entry {
+        std::uint64_t hash;
+        int key;
+        int value;
+    };
+
+    // Keys with few distinct hashes, so that some share a hash all the way down.
+    std::uint64_t hash_of(int key) { return (key % 50) * 0x9e3779b97f4a7c15; }
+
+    void set(hamt::Map<Entry>& map, int key, int value) {
+        map.set({.hash{hash_of(key)}, .key{key}, .value{value}},
+                [&](const Entry& e) { return e.key == key; });
+    }
+
+    const Entry* find(const hamt::Map<Entry>& map, int key) {
+        return map.find(hash_of(key), [&](const Entry& e) { return e.key == key; });
+    }
+} // namespace
+
+TEST(Hamt, SetFind) {
+    auto map = hamt::Map<Entry>();
+    EXPECT_EQ(find(map, 1), nullptr);
+    for (auto i = 0; i < 1000; i++) {
+        set(map, i, i * 2);
+    }
+    EXPECT_EQ(map.size(), 1000);
+    for (auto i = 0; i < 1000; i++) {
+        const auto* e = find(map, i);
+        ASSERT_NE(e, nullptr);
+        EXPECT_EQ(e->value, i * 2);
+    }
+    EXPECT_EQ(find(map, 1000), nullptr);
+
+    set(map, 7, -1);
+    EXPECT_EQ(map.size(), 1000);
+    EXPECT_EQ(find(map, 7)->value, -1);
+
+    auto sum = 0;
+    map.for_each([&](const Entry& e) { sum += e.key; });
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST(Hamt, Persistence) {
+    auto map = hamt::Map<Entry>();
+    for (auto i = 0; i < 100; i++) {
+        set(map, i, i);
+    }
+    auto copy = map;
+    set(map, 3, 30);
+    set(map, 100, 100);
+    EXPECT_EQ(find(copy, 3)->value, 3);
+    EXPECT_EQ(find(copy, 100), nullptr);
+    EXPECT_EQ(copy.size(), 100);
+    EXPECT_EQ(find(map, 3)->value, 30);
+    EXPECT_EQ(map.size(), 101);
+    // Leaves off the changed paths are shared.
+    EXPECT_EQ(find(copy, 4), find(map, 4));
+
+    // Nodes only one of them holds now are changed in place, and shared ones still copied.
+    for (auto i = 0; i < 100; i++) {
+        auto moved = false;
+        copy.edit(hash_of(i), [&](const Entry& e) { return e.key == i; }, moved).value = -i;
+    }
+    for (auto i = 0; i < 100; i++) {
+        EXPECT_EQ(find(copy, i)->value, -i);
+        EXPECT_EQ(find(map, i)->value, i == 3 ? 30 : i);
+    }
+}
+
+TEST(Hamt, EqualHashes) {
+    // Past the last bits of the hash a leaf only grows.
+    auto map = hamt::Map<Entry>();
+    for (auto i = 0; i < 200; i++) {
+        set(map, i * 50, i);
+    }
+    EXPECT_EQ(map.size(), 200);
+    for (auto i = 0; i < 200; i++) {
+        ASSERT_NE(find(map, i * 50), nullptr);
+        EXPECT_EQ(find(map, i * 50)->value, i);
+    }
+    EXPECT_EQ(find(map, 200 * 50), nullptr);
+}
+
+TEST(Hamt, Moved) {
+    auto map = hamt::Map<Entry>();
+    auto same = [](int key) { return [=](const Entry& e) { return e.key == key; }; };
+    EXPECT_TRUE(map.set({.hash{hash_of(1)}, .key{1}, .value{1}}, same(1)));
+    const auto* one = find(map, 1);
+
+    // Replacing an entry leaves it where it was.
+    EXPECT_FALSE(map.set({.hash{hash_of(1)}, .key{1}, .value{2}}, same(1)));
+    EXPECT_EQ(find(map, 1), one);
+    EXPECT_EQ(one->value, 2);
+    auto moved = false;
+    map.edit(hash_of(1), same(1), moved).value = 3;
+    EXPECT_FALSE(moved);
+    EXPECT_EQ(one->value, 3);
+
+    // Adding one, or changing a map that shares the path, may move it.
+    EXPECT_TRUE(map.set({.hash{hash_of(2)}, .key{2}, .value{2}}, same(2)));
+    auto copy = map;
+    copy.edit(hash_of(2), same(2), moved).value = 6;
+    EXPECT_TRUE(moved);
+    // The copy has a leaf of its own now, so the map's is no longer shared.
+    EXPECT_FALSE(map.set({.hash{hash_of(1)}, .key{1}, .value{4}}, same(1)));
+    moved = false;
+    map.edit(hash_of(2), same(2), moved).value = 5;
+    EXPECT_FALSE(moved);
+    EXPECT_EQ(find(map, 1)->value, 4);
+    EXPECT_EQ(find(copy, 1)->value, 3);
+    EXPECT_EQ(find(map, 2)->value, 5);
+    EXPECT_EQ(find(copy, 2)->value, 6);
+}
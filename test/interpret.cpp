@@ -18,3 +18,50 @@ TEST(Interpret, Empty) {
     interpret("", in, out, err, Config{.debug{false}});
     EXPECT_EQ(err.str(), "[ERROR] 1:1-1:0: Zero sized array are not allowed\n\n");
 }
+
+TEST(Interpret, DeepCalls) {
+    // Each call of (f) nests in the one before, far deeper than the native stack would allow.
+    const auto* src = R"(
+(S)
+; (n) := 50000
+; (f) := ((
+    (n)
+    ; (n) := (n) - 1
+    ; (f)
+))
+; (f)
+; (std_output_char) := 89
+; (std_output)
+; (S) := 0
+)";
+    std::stringstream out{};
+    std::stringstream in{};
+    std::stringstream err{};
+    interpret(src, in, out, err, Config{.debug{false}});
+    EXPECT_EQ(err.str(), "");
+    EXPECT_EQ(out.str(), "Y");
+}
+
+TEST(Interpret, RedefineRunning) {
+    // An array runs the elements it had when it started, whatever is assigned meanwhile.
+    const auto* src = R"(
+(S)
+; (n) := 3
+; (f) := ((
+    (n)
+    ; (std_output_char) := 65
+    ; (std_output)
+    ; (n) := (n) - 1
+    ; (f) := ((0))
+))
+; (f)
+; (f)
+; (S) := 0
+)";
+    std::stringstream out{};
+    std::stringstream in{};
+    std::stringstream err{};
+    interpret(src, in, out, err, Config{.debug{false}});
+    EXPECT_EQ(err.str(), "");
+    EXPECT_EQ(out.str(), "AAA");
+}
@@ -0,0 +1,66 @@
+#include "lib/mpmc.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(Mpmc, Order) {
+    // Rounded up to 4.
+    auto queue = mpmc::Queue<int>(3);
+    for (auto i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.try_push(int{i}));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    for (auto i = 0; i < 4; i++) {
+        EXPECT_EQ(queue.try_pop(), i);
+    }
+    EXPECT_EQ(queue.try_pop(), std::nullopt);
+    // Positions go around.
+    EXPECT_TRUE(queue.try_push(5));
+    EXPECT_EQ(queue.try_pop(), 5);
+}
+
+TEST(Mpmc, Full) {
+    auto queue = mpmc::Queue<std::unique_ptr<int>>(1);
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(0)));
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(1)));
+    // What isn't pushed stays with the caller.
+    auto value = std::make_unique<int>(2);
+    EXPECT_FALSE(queue.try_push(std::move(value)));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 2);
+    EXPECT_EQ(**queue.try_pop(), 0);
+}
+
+TEST(Mpmc, Threads) {
+    constexpr auto THREADS = 4;
+    constexpr auto PUSHES = 10000;
+    auto queue = mpmc::Queue<int>(64);
+    auto sums = std::vector<long>(THREADS);
+    {
+        auto threads = std::vector<std::jthread>();
+        for (auto t = 0; t < THREADS; t++) {
+            threads.emplace_back([&] {
+                for (auto i = 1; i <= PUSHES; i++) {
+                    while (!queue.try_push(int{i})) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            threads.emplace_back([&, t] {
+                for (auto popped = 0; popped < PUSHES;) {
+                    if (auto i = queue.try_pop()) {
+                        sums[t] += *i;
+                        popped++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+    }
+    auto total = 0L;
+    for (auto sum : sums) {
+        total += sum;
+    }
+    EXPECT_EQ(total, THREADS * (PUSHES * (PUSHES + 1L) / 2));
+}
@@ -1,4 +1,5 @@
 #include "lib/number.cpp"
+#include "lib/pi.hpp"
 #include <cstdlib>
 #include <gtest/gtest.h>
 #include <numbers>
@@ -48,19 +49,36 @@ TEST(Number, LexicographicallyMinimalRotationBF) {
 
 TEST(Number, ValueFromName) {
     auto n = number::Value("abcd");
-    EXPECT_EQ(n.get_numerator(), (std::vector<BigInt>{pow(number::LETTER_BASE, 0) * 'a',
-                                                      pow(number::LETTER_BASE, 1) * 'b',
-                                                      pow(number::LETTER_BASE, 2) * 'c',
-                                                      pow(number::LETTER_BASE, 3) * 'd'}));
+    EXPECT_EQ(n.get_numerator(), (std::vector<BigInt>{pow(BigInt(number::LETTER_BASE), 0) * 'a',
+                                                      pow(BigInt(number::LETTER_BASE), 1) * 'b',
+                                                      pow(BigInt(number::LETTER_BASE), 2) * 'c',
+                                                      pow(BigInt(number::LETTER_BASE), 3) * 'd'}));
     n = number::Value("bcda");
-    EXPECT_EQ(n.get_numerator(), (std::vector<BigInt>{pow(number::LETTER_BASE, 0) * 'a',
-                                                      pow(number::LETTER_BASE, 1) * 'b',
-                                                      pow(number::LETTER_BASE, 2) * 'c',
-                                                      pow(number::LETTER_BASE, 3) * 'd'}));
+    EXPECT_EQ(n.get_numerator(), (std::vector<BigInt>{pow(BigInt(number::LETTER_BASE), 0) * 'a',
+                                                      pow(BigInt(number::LETTER_BASE), 1) * 'b',
+                                                      pow(BigInt(number::LETTER_BASE), 2) * 'c',
+                                                      pow(BigInt(number::LETTER_BASE), 3) * 'd'}));
 
     EXPECT_EQ(n.to_letters(), "abcd");
 }
 
+TEST(Number, Coefficients) {
+    auto num = number::Value({0, -12, 0, 345}, {7});
+    auto c = num.get_numerator();
+    ASSERT_EQ(c.size(), 4);
+    EXPECT_TRUE(c.is_zero(0));
+    EXPECT_TRUE(c.is_negative(1));
+    EXPECT_EQ(c.magnitude(1), "12");
+    EXPECT_EQ(c[1], -12);
+    EXPECT_EQ(c.back(), 345);
+    EXPECT_EQ(c, (std::vector<BigInt>{0, -12, 0, 345}));
+    EXPECT_EQ(num.get_denominator(), (std::vector<BigInt>{7}));
+
+    auto copy = num.clone();
+    EXPECT_EQ(copy.to_string(), "{0 -12 0 345}{7}");
+    EXPECT_TRUE(number::equal(copy, num));
+}
+
 TEST(Number, PlusMinusMultiplyDivide) {
     auto pi = number::Value(1);
     EXPECT_EQ(pi.to_string(), "{0 1}{1}");
@@ -89,6 +107,39 @@ TEST(Number, PlusMinusMultiplyDivide) {
     EXPECT_EQ((pi * pi + pi - pi * pi).to_string(), "{0 1}{1}");
 }
 
+TEST(Number, SmallArithmetic) {
+    // At the bounds of machine integers the results are the same as with BigInts.
+    auto n = BigInt(999999999);
+    auto a = number::Value({n, -n, n, n - 2}, {n - 1, n, BigInt(1), BigInt(2) - n});
+    auto b = number::Value({-n, n, n - 1, n}, {n, -n, n, BigInt(7)});
+    auto small = number::Small();
+    ASSERT_TRUE(number::to_small(a.get_numerator(), small));
+    ASSERT_TRUE(number::to_small(b.get_denominator(), small));
+
+    auto ln = a.get_numerator().to_vector();
+    auto ld = a.get_denominator().to_vector();
+    auto rn = b.get_numerator().to_vector();
+    auto rd = b.get_denominator().to_vector();
+    auto cross = [](const auto& x, const auto& y) { return number::multiply(x, y); };
+    auto expect = [](const std::vector<BigInt>& num, const std::vector<BigInt>& den) {
+        return number::Value(num, den).to_string();
+    };
+    EXPECT_EQ((a + b).to_string(),
+              expect(number::plus(cross(ln, rd), cross(rn, ld), true), cross(rd, ld)));
+    EXPECT_EQ((a - b).to_string(),
+              expect(number::plus(cross(ln, rd), cross(rn, ld), false), cross(rd, ld)));
+    EXPECT_EQ((a * b).to_string(), expect(cross(ln, rn), cross(ld, rd)));
+    EXPECT_EQ((a / b).to_string(), expect(cross(ln, rd), cross(ld, rn)));
+    EXPECT_TRUE(number::equal(a * b / b, a));
+    EXPECT_FALSE(number::equal(a * b, a));
+
+    // One digit more, and BigInts take over.
+    auto big = number::Value(n) + number::Value(BigInt(1));
+    EXPECT_FALSE(number::to_small(big.get_numerator(), small));
+    EXPECT_EQ((big * big).to_string(), "{0 0 1000000000000000000}{1}");
+    EXPECT_EQ((big * big - big * big).to_string(), "{}{1}");
+}
+
 TEST(Number, Bool) {
     auto pi = number::Value(1);
     // NOLINTNEXTLINE(misc-redundant-expression)
@@ -131,7 +182,7 @@ TEST(Number, Bool) {
 
 TEST(Number, PrecisionComparison) {
     auto sf = 128;
-    auto pi = BigInt(std::string(PI, PI + sf));
+    auto pi = BigInt(pi::decimal_digits(sf));
     auto ten = big_pow10(sf - 1);
     auto f = number::Value(1);
 
@@ -153,6 +204,96 @@ TEST(Number, PrecisionComparison) {
     EXPECT_TRUE((num < num_big).to_bool());
 }
 
+TEST(Number, FloatFilter) {
+    auto pi = number::Value(1);
+    auto one = pi / pi;
+    EXPECT_EQ(number::less_than_filter(number::Value(3), number::Value(4)), true);
+    EXPECT_EQ(number::less_than_filter(pi * pi, number::Value(10)), true);
+    EXPECT_EQ(number::less_than_filter(number::Value(BigInt(0)) - pi, one), true);
+    EXPECT_EQ(number::less_than_filter(number::Value(BigInt(0)), number::Value(-1)), false);
+
+    // Too close for a double to tell apart.
+    auto sf = 32;
+    auto pi_digits = BigInt(pi::decimal_digits(sf));
+    auto ten = big_pow10(sf - 1);
+    EXPECT_EQ(number::less_than_filter(number::Value(pi_digits) / pi, number::Value(ten)),
+              std::nullopt);
+    EXPECT_TRUE((number::Value(pi_digits) / pi < number::Value(ten)).to_bool());
+
+    // Coefficients too large for a double.
+    auto huge = number::Value(big_pow10(400));
+    EXPECT_EQ(number::less_than_filter(huge, huge + pi), std::nullopt);
+    EXPECT_TRUE((huge < huge + pi).to_bool());
+}
+
+TEST(Number, EnclosureCache) {
+    auto pi = number::Value(1);
+    auto num = pi * pi - number::Value(10);
+
+    const auto& coarse = num.enclose(32);
+    EXPECT_EQ(&num.enclose(32), &coarse);
+    // The copy keeps the coarse enclosure alive once num refines its own.
+    auto copy = num.clone();
+    EXPECT_EQ(&copy.enclose(16), &coarse);
+
+    const auto& fine = num.enclose(256);
+    EXPECT_EQ(fine.bits, 256);
+    EXPECT_EQ(fine.coefficients, coarse.coefficients);
+    EXPECT_EQ(&num.enclose(64), &fine);
+
+    // Close enough to get past the floating point filter.
+    auto sf = 32;
+    auto pi_digits = BigInt(pi::decimal_digits(sf));
+    auto len = number::Value(big_pow10(sf - 1));
+    for (auto i = 0; i < 4; i++) {
+        EXPECT_TRUE((number::Value(pi_digits - i) / pi < len).to_bool());
+    }
+    EXPECT_GE(len.enclose(1).bits, 64);
+}
+
+TEST(Number, StartPrecision) {
+    auto pi = number::Value(1);
+    auto sf = 64;
+    auto pi_digits = BigInt(pi::decimal_digits(sf));
+    auto ten = number::Value(big_pow10(sf - 1));
+    auto num = number::Value(pi_digits) / pi;
+    EXPECT_TRUE((num < ten).to_bool());
+    auto bits = number::start_bits(num, ten).bits;
+    EXPECT_GT(bits, 128);
+
+    // The next comparison of the same shape starts right there.
+    auto next = number::Value(pi_digits + 1) / pi;
+    EXPECT_TRUE((ten < next).to_bool());
+    EXPECT_EQ(number::start_bits(next, ten).bits, bits);
+    EXPECT_EQ(next.enclose(1).bits, bits);
+}
+
+TEST(Number, StartPerShape) {
+    auto pi = number::Value(1);
+    auto sf = 64;
+    auto pi_digits = BigInt(pi::decimal_digits(sf));
+    auto ten = number::Value(big_pow10(sf - 1));
+    EXPECT_TRUE((number::Value(pi_digits) / pi < ten).to_bool());
+    auto start = number::start_bits(number::Value(pi_digits) / pi, ten);
+    EXPECT_GT(start.bits, 128);
+    EXPECT_LE(start.bits, number::BALL_BITS);
+
+    // Another shape, however hard, leaves this one alone.
+    sf = 1000;
+    auto len = number::Value(big_pow10(sf - 1));
+    auto factor = pi * pi + pi / pi;
+    auto hard = number::Value(BigInt(pi::decimal_digits(sf))) / pi * factor / factor;
+    for (auto i = 0; i < number::RESTART_EVERY; i++) {
+        EXPECT_TRUE((hard < len).to_bool());
+    }
+    EXPECT_GT(number::start_bits(hard, len).bits, number::BALL_BITS);
+    auto next = number::Value(pi_digits + 1) / pi;
+    EXPECT_EQ(number::start_bits(next, ten).bits, start.bits);
+    EXPECT_EQ(number::start_bits(next, ten).calls, start.calls);
+    EXPECT_TRUE((ten < next).to_bool());
+    EXPECT_EQ(next.enclose(1).bits, start.bits);
+}
+
 TEST(Number, Index) {
     auto pi = number::Value(1);
     // NOLINTNEXTLINE(misc-redundant-expression)
@@ -190,3 +331,46 @@ TEST(Number, Index) {
     EXPECT_FALSE(map.contains(ind4));
     EXPECT_FALSE(map.contains(ind5));
 }
+
+TEST(Number, HashNegative) {
+    // Indices a multiple of length * pi apart are the same index, on either side of zero.
+    auto length = 5;
+    auto third = number::Value(1) / number::Value(3);
+    auto negative = number::Value(BigInt(0)) - third;
+    for (auto k = -3; k <= 3; k++) {
+        auto shifted = negative + number::Value(length * k);
+        EXPECT_TRUE(number::index_equal(negative, shifted, length)) << k;
+        EXPECT_EQ(number::hash(negative, length), number::hash(shifted, length)) << k;
+    }
+    EXPECT_FALSE(number::index_equal(negative, third, length));
+}
+
+TEST(Number, ExactComparison) {
+    // Close enough that ball arithmetic gives up at BALL_BITS.
+    auto sf = 1000;
+    auto pi_digits = BigInt(pi::decimal_digits(sf));
+    auto len = number::Value(big_pow10(sf - 1));
+    auto num = number::Value(pi_digits) / number::Value(1);
+    EXPECT_EQ(number::less_than(num, len, number::BALL_BITS), std::nullopt);
+    EXPECT_EQ(number::less_than_exact(num, len), true);
+    EXPECT_TRUE((num < len).to_bool());
+    EXPECT_TRUE((len < number::Value(pi_digits + 1) / number::Value(1)).to_bool());
+}
+
+TEST(Number, StartRecovers) {
+    auto sf = 1000;
+    auto pi_digits = BigInt(pi::decimal_digits(sf));
+    auto len = number::Value(big_pow10(sf - 1));
+    auto hard = number::Value(pi_digits) / number::Value(1);
+    EXPECT_TRUE((hard < len).to_bool());
+    EXPECT_GT(number::start_bits(hard, len).bits, number::BALL_BITS);
+
+    // Easy comparisons of the same shape soon go back to balls, and stay there.
+    auto easy = number::Value(pi_digits - big_pow10(sf - 30)) / number::Value(1);
+    for (auto i = 0; i < number::RESTART_EVERY; i++) {
+        EXPECT_TRUE((easy < len).to_bool());
+    }
+    EXPECT_LE(number::start_bits(easy, len).bits, number::BALL_BITS);
+    EXPECT_TRUE((easy < len).to_bool());
+    EXPECT_LE(number::start_bits(easy, len).bits, 256);
+}
@@ -0,0 +1,83 @@
+#include "lib/pi.cpp"
+
+#include <gtest/gtest.h>
+
+TEST(Pi, Table) {
+    EXPECT_EQ(pi::LIMBS[0], 3);
+    EXPECT_EQ(pi::LIMBS[1], 0x243f6a8885a308d3);
+    EXPECT_EQ(pi::limbs(100).data(), pi::LIMBS);
+
+    auto limbs = pi::chudnovsky(4096);
+    ASSERT_EQ(limbs.size(), 4096 / 64 + 1);
+    EXPECT_TRUE(std::ranges::equal(std::span(limbs).first(limbs.size() - 1),
+                                   std::span(pi::LIMBS).first(limbs.size() - 1)));
+}
+
+TEST(Pi, Powers) {
+    for (auto k = 0U; k < pi::POWER_COUNT; k++) {
+        auto limbs = pi::chudnovsky(pi::POWER_BITS, k);
+        ASSERT_EQ(limbs.size(), pi::POWER_LIMBS);
+        EXPECT_TRUE(std::ranges::equal(std::span(limbs).first(pi::POWER_LIMBS - 1),
+                                       std::span(pi::POWERS[k]).first(pi::POWER_LIMBS - 1)))
+            << k;
+    }
+    EXPECT_EQ(pi::POWERS[0][0], 1);
+    EXPECT_EQ(pi::POWERS[2][0], 9);
+}
+
+TEST(Pi, DecimalDigits) {
+    EXPECT_EQ(pi::decimal_digits(50), "31415926535897932384626433832795028841971693993751");
+    EXPECT_EQ(pi::decimal_digits(1), "3");
+}
+
+TEST(Pi, Extension) {
+    auto dir = std::filesystem::temp_directory_path() /
+               std::format("circle-lang-pi-{}", std::random_device()());
+    auto path = dir / "circle-lang" / "pi-limbs";
+    auto expected = pi::chudnovsky(pi::TABLE_BITS * 2);
+    // Every limb but the last, which may round differently.
+    auto agrees = [&](std::span<const std::uint64_t> limbs, std::size_t bits) {
+        auto count = bits / 64;
+        return limbs.size() > count &&
+               std::ranges::equal(limbs.first(count), std::span(expected).first(count));
+    };
+    auto read = [&] {
+        auto file = std::ifstream(path, std::ios::binary);
+        auto bytes = std::vector<char>(std::istreambuf_iterator(file), {});
+        return bytes;
+    };
+    auto parses = [&](const std::vector<char>& bytes) {
+        return pi::parse(std::as_bytes(std::span(bytes))).has_value();
+    };
+
+    // Mapped from a cache file, then computed once it's too short, without invalidating the first.
+    auto small = pi::chudnovsky(pi::TABLE_BITS + 64);
+    pi::store(path, small);
+    auto extension = pi::Extension(path);
+    auto first = extension.limbs(pi::TABLE_BITS + 64);
+    EXPECT_TRUE(agrees(first, pi::TABLE_BITS));
+    auto second = extension.limbs(pi::TABLE_BITS * 2);
+    EXPECT_TRUE(agrees(second, pi::TABLE_BITS * 2));
+    EXPECT_TRUE(agrees(first, pi::TABLE_BITS));
+    EXPECT_EQ(extension.limbs(pi::TABLE_BITS * 2).data(), second.data());
+    EXPECT_TRUE(parses(read()));
+
+    // A corrupt limb past the compiled table is caught, and the file computed again.
+    auto bytes = read();
+    bytes[bytes.size() - 2 * sizeof(std::uint64_t)] ^= 1;
+    EXPECT_FALSE(parses(bytes));
+    EXPECT_FALSE(parses(std::vector(bytes.begin(), bytes.end() - 1)));
+    {
+        auto file = std::ofstream(path, std::ios::binary);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    EXPECT_TRUE(agrees(pi::Extension(path).limbs(pi::TABLE_BITS * 2), pi::TABLE_BITS * 2));
+    EXPECT_TRUE(parses(read()));
+
+    // The cache is found through XDG_CACHE_HOME.
+    ::setenv("XDG_CACHE_HOME", dir.c_str(), 1);
+    EXPECT_TRUE(agrees(pi::limbs(pi::TABLE_BITS * 2), pi::TABLE_BITS * 2));
+    ::unsetenv("XDG_CACHE_HOME");
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,99 @@
+#include "lib/radix.hpp"
+#include <gtest/gtest.h>
+
+TEST(Radix, EditRead) {
+    for (auto size : {1, 5, 32, 33, 1024, 1025, 40000}) {
+        auto vec = radix::Vector<int>(size);
+        EXPECT_EQ(vec.size(), size);
+        EXPECT_EQ(vec[size - 1], 0);
+        for (auto i = 0; i < size; i += 7) {
+            vec.edit(i) = i + 1;
+        }
+        for (auto i = 0; i < size; i++) {
+            ASSERT_EQ(vec[i], i % 7 == 0 ? i + 1 : 0) << size << " " << i;
+        }
+
+        // Only the nodes something was set in are visited.
+        auto sum = 0L;
+        vec.for_each([&](std::size_t i, int v) { sum += v - (v == 0 ? 0 : static_cast<int>(i)); });
+        EXPECT_EQ(sum, (size + 6) / 7);
+    }
+}
+
+TEST(Radix, Bulk) {
+    for (auto size : {0, 1, 32, 33, 1025}) {
+        auto items = std::vector<int>(size);
+        for (auto i = 0; i < size; i++) {
+            items[i] = i * 3;
+        }
+        auto vec = radix::Vector<int>(std::move(items));
+        EXPECT_EQ(vec.size(), size);
+        for (auto i = 0; i < size; i++) {
+            ASSERT_EQ(vec[i], i * 3);
+        }
+        auto count = 0;
+        vec.for_each([&](std::size_t i, int v) {
+            EXPECT_EQ(v, i * 3);
+            count++;
+        });
+        EXPECT_EQ(count, size);
+    }
+}
+
+TEST(Radix, Persistence) {
+    auto items = std::vector<std::shared_ptr<int>>();
+    for (auto i = 0; i < 2000; i++) {
+        items.push_back(std::make_shared<int>(i));
+    }
+    auto vec = radix::Vector<std::shared_ptr<int>>(std::move(items));
+    auto copy = vec;
+    vec.edit(1500) = std::make_shared<int>(-1);
+    EXPECT_EQ(*vec[1500], -1);
+    EXPECT_EQ(*copy[1500], 1500);
+    // Untouched items are shared.
+    EXPECT_EQ(vec[3], copy[3]);
+    EXPECT_EQ(vec[1501], copy[1501]);
+
+    // Nodes only one of them holds now are changed in place, and shared ones still copied.
+    for (auto i = 0; i < 2000; i += 3) {
+        copy.edit(i) = std::make_shared<int>(-i);
+    }
+    for (auto i = 0; i < 2000; i++) {
+        EXPECT_EQ(*copy[i], i % 3 == 0 ? -i : i);
+        EXPECT_EQ(*vec[i], i == 1500 ? -1 : i);
+    }
+}
+
+TEST(Radix, Inline) {
+    for (auto size : {0, 1, 4, 5, 40}) {
+        auto items = std::vector<int>(size, 1);
+        auto vec = radix::Vector<int, 4>(std::move(items));
+        auto copy = vec;
+        for (auto i = 0; i < size; i++) {
+            vec.edit(i) = i;
+        }
+        auto count = 0;
+        vec.for_each([&](std::size_t i, int v) {
+            EXPECT_EQ(v, i);
+            EXPECT_EQ(copy[i], 1);
+            count++;
+        });
+        EXPECT_EQ(count, size);
+    }
+}
+
+TEST(Radix, Moved) {
+    auto vec = radix::Vector<int>(100);
+    auto moved = false;
+    auto* item = &vec.edit(40, moved);
+    EXPECT_TRUE(moved);
+    // Once made, items stay where they are, until a copy shares them.
+    moved = false;
+    EXPECT_EQ(&vec.edit(40, moved), item);
+    EXPECT_EQ(&vec.edit(41, moved), item + 1);
+    EXPECT_FALSE(moved);
+    auto copy = vec;
+    EXPECT_NE(&vec.edit(40, moved), item);
+    EXPECT_TRUE(moved);
+    EXPECT_EQ(&copy[40], item);
+}
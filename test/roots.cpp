@@ -0,0 +1,51 @@
+#include "lib/roots.cpp"
+#include "lib/pi.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+    std::vector<ball::Int> poly(std::initializer_list<ball::Int> coefficients) {
+        return coefficients;
+    }
+} // namespace
+
+TEST(Roots, Arithmetic) {
+    auto p = poly({-1, 1});
+    auto q = poly({1, 1});
+    EXPECT_EQ(roots::multiply(p, q), poly({-1, 0, 1}));
+    EXPECT_EQ(roots::subtract(p, roots::multiply(p, q)), poly({0, 1, -1}));
+}
+
+TEST(Roots, CountBetween) {
+    // (x - 1)(x - 2)(x - 3)
+    auto p = poly({-6, 11, -6, 1});
+    EXPECT_EQ(roots::count_between(p, 0, 4, 0), 3);
+    EXPECT_EQ(roots::count_between(p, 3, 7, 1), 2);
+    EXPECT_EQ(roots::count_between(p, 7, 13, 2), 2);
+    EXPECT_EQ(roots::count_between(p, 9, 13, 2), 1);
+    EXPECT_EQ(roots::count_between(p, 13, 16, 2), 0);
+    // x^2 + 1 has no real roots, but only an interval clear of i rules them out.
+    EXPECT_EQ(roots::count_between(poly({1, 0, 1}), -8, 8, 0), 2);
+    EXPECT_EQ(roots::count_between(poly({1, 0, 1}), 1, 8, 0), 0);
+
+    EXPECT_EQ(roots::sign_at(p, 3, 1), 1);
+    EXPECT_EQ(roots::sign_at(p, 5, 1), -1);
+    EXPECT_EQ(roots::sign_at(p, 2, 0), 0);
+}
+
+TEST(Roots, SignAtPi) {
+    EXPECT_EQ(roots::sign_at_pi(poly({-3, 1})), 1);
+    EXPECT_EQ(roots::sign_at_pi(poly({-22, 7})), -1);
+    EXPECT_EQ(roots::sign_at_pi(poly({-355, 113})), -1);
+    EXPECT_EQ(roots::sign_at_pi(poly({10, 0, -1})), 1);
+    EXPECT_EQ(roots::sign_at_pi(poly({9, 0, -1})), -1);
+    EXPECT_EQ(roots::sign_at_pi(poly({0, 0})), 0);
+
+    // A root 10^-300 away from pi.
+    auto digits = 301;
+    auto truncated = ball::Int(pi::decimal_digits(digits));
+    auto scale = pow(ball::Int(10), digits - 1);
+    EXPECT_EQ(roots::sign_at_pi(poly({-truncated, scale})), 1);
+    EXPECT_EQ(roots::sign_at_pi(poly({-truncated - 1, scale})), -1);
+    // Large coefficients alone don't call for more digits.
+    EXPECT_EQ(roots::sign_at_pi(poly({-truncated * 3, scale * 3})), 1);
+}
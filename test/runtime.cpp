@@ -0,0 +1,397 @@
+#include "lib/runtime.hpp"
+#include <functional>
+#include <future>
+#include <gtest/gtest.h>
+
+namespace {
+    using Array = runtime::Array<false>;
+    using Number = runtime::Number<false>;
+
+    void insert(Array& arr, number::Value&& i, number::Value&& v) {
+        auto loc = std::vector<diag::WithInfo<number::Value>>();
+        loc.emplace_back(diag::Range{}, std::move(i));
+        arr.insert(std::move(loc), std::make_unique<Number>(std::move(v), std::nullopt));
+    }
+
+    number::Value at(const Array& arr, const number::Value& i) {
+        auto e = arr.index(i);
+        const auto* n = dynamic_cast<const Number*>(e.get());
+        EXPECT_NE(n, nullptr);
+        return n->get_value().clone();
+    }
+
+    // An array big enough for the reclaimer to want, which calls `on_free` as it's freed.
+    std::shared_ptr<const runtime::Obj<false>> probe(std::function<void()> on_free) {
+        auto arr = std::make_unique<Array>(64, std::nullopt);
+        for (auto i = 0; i < 64; i++) {
+            insert(*arr, number::Value(BigInt(i)), number::Value(BigInt(i)));
+        }
+        return {arr.release(), [on_free = std::move(on_free)](const runtime::Obj<false>* obj) {
+                    on_free();
+                    delete obj;
+                }};
+    }
+} // namespace
+
+TEST(Runtime, ArrayIndex) {
+    auto arr = Array(3, std::nullopt);
+    insert(arr, number::Value(1), number::Value(10));
+    EXPECT_TRUE(number::equal(at(arr, number::Value(1)), number::Value(10)));
+    // Integer multiples of pi wrap around the length, negative ones included.
+    EXPECT_TRUE(number::equal(at(arr, number::Value(4)), number::Value(10)));
+    EXPECT_TRUE(number::equal(at(arr, number::Value(-2)), number::Value(10)));
+    insert(arr, number::Value(-5), number::Value(20));
+    EXPECT_TRUE(number::equal(at(arr, number::Value(1)), number::Value(20)));
+
+    // Anything else lives apart, and still wraps by the length times pi.
+    insert(arr, number::Value("abc"), number::Value(30));
+    EXPECT_TRUE(number::equal(at(arr, number::Value("abc") + number::Value(3)), number::Value(30)));
+    EXPECT_TRUE(number::equal(at(arr, number::Value(1)), number::Value(20)));
+
+    // Unset elements read as pi.
+    EXPECT_TRUE(number::equal(at(arr, number::Value(2)), number::Value(1)));
+    EXPECT_TRUE(number::equal(at(arr, number::Value("abd")), number::Value(1)));
+
+    auto copy = arr.clone();
+    insert(arr, number::Value(1), number::Value(40));
+    EXPECT_TRUE(
+        number::equal(at(dynamic_cast<const Array&>(*copy), number::Value(1)), number::Value(20)));
+}
+
+TEST(Runtime, SparseElements) {
+    // The first few are scanned, and the rest moved to a table, all still found.
+    auto arr = Array(3, std::nullopt);
+    auto key = [](int i) {
+        return number::Value("k") + number::Value(BigInt(i)) / number::Value(5);
+    };
+    for (auto i = 0; i < 40; i++) {
+        insert(arr, key(i), number::Value(BigInt(i)));
+        EXPECT_EQ(arr.size(), i + 1);
+        for (auto j = 0; j <= i; j++) {
+            EXPECT_TRUE(
+                number::equal(at(arr, key(j) + number::Value(3)), number::Value(BigInt(j))));
+        }
+    }
+    insert(arr, key(0), number::Value(-1));
+    EXPECT_EQ(arr.size(), 40);
+    EXPECT_TRUE(number::equal(at(arr, key(0)), number::Value(-1)));
+    EXPECT_TRUE(number::equal(at(arr, key(40)), number::Value(1)));
+}
+
+TEST(Runtime, ArrayCopy) {
+    auto arr = Array(3, std::nullopt);
+    auto inner = std::make_unique<Array>(2, std::nullopt);
+    auto loc = std::vector<diag::WithInfo<number::Value>>();
+    loc.emplace_back(diag::Range{}, number::Value(2));
+    arr.insert(std::move(loc), std::move(inner));
+    for (auto i = 0; i < 100; i++) {
+        insert(arr, number::Value("abc") + number::Value(BigInt(i)) / number::Value(7),
+               number::Value(BigInt(i)));
+    }
+
+    // Copies share everything, and writing through a path copies only that path.
+    auto copy = arr.clone();
+    auto set_inner = [&](number::Value&& v) {
+        auto loc = std::vector<diag::WithInfo<number::Value>>();
+        loc.emplace_back(diag::Range{}, number::Value(2));
+        loc.emplace_back(diag::Range{}, number::Value(1));
+        arr.insert(std::move(loc), std::make_unique<Number>(std::move(v), std::nullopt));
+    };
+    set_inner(number::Value(5));
+    insert(arr, number::Value("abc"), number::Value(6));
+
+    auto inner_at = [](const Array& a) {
+        auto e = a.index(number::Value(2));
+        return at(dynamic_cast<const Array&>(*e), number::Value(1));
+    };
+    EXPECT_TRUE(number::equal(inner_at(arr), number::Value(5)));
+    EXPECT_TRUE(number::equal(inner_at(dynamic_cast<const Array&>(*copy)), number::Value(1)));
+    EXPECT_TRUE(number::equal(at(arr, number::Value("abc")), number::Value(6)));
+    EXPECT_TRUE(number::equal(at(dynamic_cast<const Array&>(*copy), number::Value("abc")),
+                              number::Value(BigInt(0))));
+    EXPECT_TRUE(number::equal(
+        at(dynamic_cast<const Array&>(*copy), number::Value("abc") + number::Value(BigInt(99)) /
+                                                                 number::Value(7)),
+        number::Value(BigInt(99))));
+
+    // Indexing through a number fails like before.
+    auto loc2 = std::vector<diag::WithInfo<number::Value>>();
+    loc2.emplace_back(diag::Range{}, number::Value("abc"));
+    loc2.emplace_back(diag::Range{}, number::Value(1));
+    EXPECT_THROW(
+        arr.insert(std::move(loc2), std::make_unique<Number>(number::Value(1), std::nullopt)),
+        diag::RuntimeError);
+}
+
+TEST(Runtime, SharedCode) {
+    auto diags = diag::Diags();
+    auto parsed = parse("(a) := (b) + 1; ((0; (c) := 2))", diags);
+    ASSERT_TRUE(parsed);
+    auto arr = Array(std::move(*parsed), diag::Range{});
+
+    // Reading an element hands out the stored node, and copies of the array share it.
+    auto assign = arr.index(number::Value(BigInt(0)));
+    EXPECT_EQ(assign.get(), arr.index(number::Value(2)).get());
+    auto copy = arr.clone();
+    EXPECT_EQ(dynamic_cast<const Array&>(*copy).index(number::Value(1)).get(),
+              arr.index(number::Value(1)).get());
+    EXPECT_EQ(assign->debug_string(0), assign->clone()->debug_string(0));
+}
+
+TEST(Runtime, BorrowedEvaluation) {
+    auto gca = Array(1, std::nullopt);
+    insert(gca, number::Value("x"), number::Value(7));
+    auto diags = diag::Diags();
+    auto parsed = parse("(x); (x) + 1", diags);
+    ASSERT_TRUE(parsed);
+    auto read = runtime::from_ast<false>(std::move(parsed->elements[0]));
+    auto sum = runtime::from_ast<false>(std::move(parsed->elements[1]));
+
+    // Reading the GCA borrows what is stored there, and only new values are owned.
+    auto x = read->evaluate(gca);
+    EXPECT_FALSE(x.is_owned());
+    EXPECT_EQ(x.get(), gca.index(number::Value("x")).get());
+    EXPECT_EQ(std::move(x).share(), gca.index(number::Value("x")));
+
+    // Computed numbers are held in the Ref itself, and become a Number when stored.
+    auto y = sum->evaluate(gca);
+    EXPECT_TRUE(y.is_owned());
+    EXPECT_EQ(y.get(), nullptr);
+    EXPECT_TRUE(number::equal(*y.as_number(), number::Value(8)));
+    auto stored = std::move(y).share();
+    EXPECT_TRUE(number::equal(dynamic_cast<const Number&>(*stored).get_value(), number::Value(8)));
+}
+
+TEST(Runtime, Kind) {
+    auto arr = Array(1, std::nullopt);
+    insert(arr, number::Value(BigInt(0)), number::Value(3));
+    const auto& e = arr.at(number::Value(BigInt(0)));
+    EXPECT_EQ(e.kind(), runtime::Kind::number);
+    EXPECT_EQ(runtime::as<Number>(&e), &e);
+    EXPECT_EQ(runtime::as<Array>(&e), nullptr);
+    EXPECT_EQ(runtime::as<Array>(static_cast<const runtime::Obj<false>*>(&arr)), &arr);
+}
+
+TEST(Runtime, AssignPath) {
+    auto gca = Array(1, std::nullopt);
+    auto diags = diag::Diags();
+    auto parsed = parse("(a) := ((1; 2)); (a)(1) := ((3)); (a)(1)(0) := 4; (b)(0) := 5", diags);
+    ASSERT_TRUE(parsed);
+    auto code = std::vector<std::shared_ptr<const runtime::Obj<false>>>();
+    for (auto& e : parsed->elements) {
+        code.push_back(runtime::from_ast<false>(std::move(e)));
+    }
+    auto debugger = runtime::Debugger<false>(ast::Array{}, "");
+    auto io = std::stringstream();
+    auto run = [&](int i) { runtime::execute(*code[i], gca, io, io, io, debugger); };
+    run(0);
+    auto before = gca.index(number::Value("a"));
+    run(1);
+    run(2);
+
+    // Arrays along the path are copied, leaving the ones read before as they were.
+    const auto* a = runtime::as<Array>(gca.index(number::Value("a")).get());
+    ASSERT_NE(a, nullptr);
+    const auto* inner = runtime::as<Array>(a->index(number::Value(1)).get());
+    ASSERT_NE(inner, nullptr);
+    EXPECT_TRUE(number::equal(at(*inner, number::Value(BigInt(0))), number::Value(4)));
+    EXPECT_EQ(a->index(number::Value(BigInt(0))).get(),
+              runtime::as<Array>(before.get())->index(number::Value(BigInt(0))).get());
+    EXPECT_TRUE(number::equal(at(*runtime::as<Array>(before.get()), number::Value(1)),
+                              number::Value(2)));
+
+    // Once nothing else holds them, they're changed in place.
+    before = nullptr;
+    run(2);
+    EXPECT_EQ(runtime::as<Array>(gca.index(number::Value("a")).get()), a);
+    EXPECT_EQ(runtime::as<Array>(a->index(number::Value(1)).get()), inner);
+
+    // Indexing through anything but an array fails, and changes nothing.
+    EXPECT_THROW(run(3), diag::RuntimeError);
+    EXPECT_TRUE(number::equal(at(gca, number::Value("b")), number::Value(1)));
+}
+
+TEST(Runtime, NodeLayout) {
+    // The common expression nodes fit in a cache line.
+    EXPECT_LE(sizeof(runtime::Index<false>), 64);
+    EXPECT_LE(sizeof(runtime::Assign<false>), 64);
+    EXPECT_LE(sizeof(runtime::OperatorBinary<false>), 64);
+    EXPECT_LE(sizeof(Array), 64);
+
+    // Their ranges are kept apart, and copies share them.
+    auto diags = diag::Diags();
+    auto parsed = parse("(a) := 1 + 2", diags);
+    ASSERT_TRUE(parsed);
+    auto range = parsed->elements[0].range;
+    auto obj = runtime::from_ast<false>(std::move(parsed->elements[0]));
+    EXPECT_EQ(obj->get_range(), range);
+    auto copy = obj->clone();
+    EXPECT_EQ(copy->range_id().id(), obj->range_id().id());
+    EXPECT_EQ(Number(number::Value(1), std::nullopt).range_id().id(), 0);
+    EXPECT_EQ(Number(number::Value(1), std::nullopt).get_range(), std::nullopt);
+}
+
+TEST(Runtime, RangeReuse) {
+    // Ranges go with the last object holding them, so loading a program again takes no more.
+    auto& table = runtime::RangeTable::instance();
+    auto before = table.size();
+    for (auto i = 0; i < 3; i++) {
+        auto diags = diag::Diags();
+        auto parsed = parse("(a) := 1 + 2; (b) := (( (a); 3 ))", diags);
+        ASSERT_TRUE(parsed);
+        auto obj = runtime::from_ast<false>(std::move(parsed->elements[1]));
+        auto copy = obj->clone();
+        EXPECT_GT(table.size(), before);
+        obj = nullptr;
+        EXPECT_GT(table.size(), before);
+        copy = nullptr;
+        EXPECT_EQ(table.size(), before);
+    }
+}
+
+TEST(Runtime, DeepArrays) {
+    // Each array holds the one before at 0, and freeing the last frees them all.
+    auto last = std::make_shared<Array>(1, std::nullopt);
+    for (auto i = 0; i < 200000; i++) {
+        auto next = std::make_shared<Array>(1, std::nullopt);
+        auto loc = std::vector<diag::WithInfo<number::Value>>();
+        loc.emplace_back(diag::Range{}, number::Value(BigInt(0)));
+        next->insert(std::move(loc), std::move(last));
+        last = std::move(next);
+    }
+    EXPECT_EQ(last->index(number::Value(BigInt(0)))->kind(), runtime::Kind::array);
+    last.reset();
+}
+
+TEST(Runtime, DeepExpression) {
+    constexpr auto DEPTH = 100000;
+    auto node = ast::Node<ast::Any>{
+        .range{}, .t{std::make_unique<ast::Any>(ast::Number{number::Value(BigInt(0))})}};
+    for (auto i = 0; i < DEPTH; i++) {
+        auto t = std::make_unique<ast::Any>(
+            ast::OperatorUnary{.kind{number::op::bool_not}, .rhs{std::move(node)}});
+        node = ast::Node<ast::Any>{.range{}, .t{std::move(t)}};
+    }
+    // Converting, printing and freeing all take constant native stack.
+    auto obj = runtime::from_ast<false>(std::move(node));
+    EXPECT_EQ(obj->debug_string(0),
+              std::string(DEPTH, '!') + diag::to_string(number::Value(BigInt(0))));
+    obj.reset();
+}
+
+TEST(Runtime, LookupCache) {
+    auto arr = Array(2, std::nullopt);
+    auto cache = Array::Cache();
+    // Unset, and cached as such until the array changes.
+    EXPECT_TRUE(number::equal(
+        runtime::as<Number>(&arr.at(number::Value("x"), cache))->get_value(), number::Value(1)));
+    insert(arr, number::Value("x"), number::Value(5));
+    const auto& x = arr.at(number::Value("x"), cache);
+    EXPECT_EQ(&x, &arr.at(number::Value("x")));
+
+    // Copies share the lookup, and a change to either only redoes it there.
+    auto copy = Array(std::move(dynamic_cast<Array&>(*arr.clone())));
+    EXPECT_EQ(&copy.at(number::Value("x"), cache), &x);
+    insert(copy, number::Value("y"), number::Value(6));
+    insert(copy, number::Value("x"), number::Value(7));
+    EXPECT_TRUE(number::equal(runtime::as<Number>(&copy.at(number::Value("x"), cache))->get_value(),
+                              number::Value(7)));
+    EXPECT_EQ(&arr.at(number::Value("x"), cache), &x);
+
+    // Arrays built whole look up like any other.
+    auto elements = std::vector<std::shared_ptr<const runtime::Obj<false>>>();
+    elements.push_back(std::make_shared<Number>(number::Value(8), std::nullopt));
+    const auto* eight = elements[0].get();
+    auto literal = Array(elements, runtime::RangeId());
+    auto fresh = Array::Cache();
+    EXPECT_EQ(&literal.at(number::Value(BigInt(0)), fresh), eight);
+}
+
+TEST(Runtime, LookupCacheOverwrite) {
+    // Values replaced in place are read through the cache, and whatever moves them redoes it.
+    auto arr = Array(100, std::nullopt);
+    auto dense = Array::Cache();
+    auto sparse = Array::Cache();
+    auto read = [](const Array& arr, Array::Cache& cache, const number::Value& i) {
+        return runtime::as<Number>(&arr.at(i, cache))->get_value().clone();
+    };
+    for (auto i = 0; i < 50; i++) {
+        insert(arr, number::Value(70), number::Value(BigInt(i)));
+        insert(arr, number::Value("x"), number::Value(BigInt(-i)));
+        EXPECT_TRUE(number::equal(read(arr, dense, number::Value(70)), number::Value(BigInt(i))));
+        EXPECT_TRUE(
+            number::equal(read(arr, sparse, number::Value("x")), number::Value(BigInt(-i))));
+        // Other elements, which grow and split what holds these.
+        insert(arr, number::Value("k") + number::Value(BigInt(i)) / number::Value(3),
+               number::Value(BigInt(i)));
+        insert(arr, number::Value(i), number::Value(BigInt(i)));
+    }
+
+    auto copy = arr.clone();
+    insert(arr, number::Value(70), number::Value(-1));
+    insert(arr, number::Value("x"), number::Value(-2));
+    EXPECT_TRUE(number::equal(read(arr, dense, number::Value(70)), number::Value(-1)));
+    EXPECT_TRUE(number::equal(read(arr, sparse, number::Value("x")), number::Value(-2)));
+    const auto& original = dynamic_cast<const Array&>(*copy);
+    EXPECT_TRUE(number::equal(read(original, dense, number::Value(70)), number::Value(BigInt(49))));
+    EXPECT_TRUE(
+        number::equal(read(original, sparse, number::Value("x")), number::Value(BigInt(-49))));
+}
+
+TEST(Runtime, CallInPlace) {
+    auto gca = Array(1, std::nullopt);
+    auto diags = diag::Diags();
+    auto parsed = parse("(f) := (( (c); (c) := 0; (n) := (n) + 1 )); (f)", diags);
+    ASSERT_TRUE(parsed);
+    auto code = std::vector<std::shared_ptr<const runtime::Obj<false>>>();
+    for (auto& e : parsed->elements) {
+        code.push_back(runtime::from_ast<false>(std::move(e)));
+    }
+    auto debugger = runtime::Debugger<false>(ast::Array{}, "");
+    auto io = std::stringstream();
+    insert(gca, number::Value("n"), number::Value(BigInt(0)));
+    runtime::execute(*code[0], gca, io, io, io, debugger);
+    auto f = gca.index(number::Value("f"));
+    auto uses = f.use_count();
+
+    // The stored array runs as it is, pinned only while it runs.
+    runtime::execute(*code[1], gca, io, io, io, debugger);
+    EXPECT_TRUE(number::equal(at(gca, number::Value("n")), number::Value(1)));
+    EXPECT_EQ(gca.index(number::Value("f")), f);
+    EXPECT_EQ(f.use_count(), uses);
+}
+
+TEST(Runtime, BackgroundReclaim) {
+    auto freed = std::make_shared<std::promise<std::thread::id>>();
+    auto gca = Array(1, std::nullopt);
+    auto loc = std::vector<diag::WithInfo<number::Value>>();
+    loc.emplace_back(diag::Range{}, number::Value("x"));
+    gca.insert(std::move(loc), probe([freed] { freed->set_value(std::this_thread::get_id()); }));
+
+    // Overwriting the only reference hands it over to be freed on the reclaimer's thread.
+    insert(gca, number::Value("x"), number::Value(BigInt(0)));
+    auto thread = freed->get_future();
+    ASSERT_EQ(thread.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_NE(thread.get(), std::this_thread::get_id());
+}
+
+TEST(Runtime, ReclaimBacklog) {
+    // Hold the reclaimer's thread inside freeing one array.
+    auto started = std::make_shared<std::promise<void>>();
+    auto resume = std::make_shared<std::promise<void>>();
+    runtime::reclaim<false>(probe([started, future = resume->get_future().share()] {
+        started->set_value();
+        future.wait_for(std::chrono::seconds(10));
+    }));
+    ASSERT_EQ(started->get_future().wait_for(std::chrono::seconds(10)),
+              std::future_status::ready);
+
+    // With the backlog full, an array is freed right away on this thread.
+    for (auto i = 0; i < 1024; i++) {
+        runtime::reclaim<false>(probe([] {}));
+    }
+    auto thread = std::optional<std::thread::id>();
+    runtime::reclaim<false>(probe([&thread] { thread = std::this_thread::get_id(); }));
+    EXPECT_EQ(thread, std::this_thread::get_id());
+    resume->set_value();
+}